@@ -0,0 +1,92 @@
+// simulate a cache under one of the registered replacement policies.  the
+// access itself is in cache_access.h.
+
+#include <stdio.h>
+#include <assert.h>
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+
+using namespace std;
+
+// log base 2
+
+int lg2 (int n) {
+	int i, m = n, c = -1;
+	for (i=0; m; i++) {
+		m /= 2;
+		c++;
+	}
+	assert (n == 1<<c);
+	return c;
+}
+
+// make a cache.  blocksize must be a power of 2; nsets needn't be.
+
+void init_cache (cache *c, int nsets, int assoc, int blocksize, const policy_info *policy, int set_shift) {
+	assert (nsets > 0 && assoc > 0 && assoc <= MAX_ASSOC);
+	c->sets = new set[nsets];
+	c->tag_stride = (assoc + 3) & ~3;
+	size_t tag_bytes = (size_t) nsets * c->tag_stride * sizeof (unsigned long long int);
+	if (posix_memalign ((void **) &c->tags, 64, tag_bytes)) {
+		fprintf (stderr, "out of memory for the cache\n");
+		exit (1);
+	}
+	memset (c->tags, 0, tag_bytes);
+	c->blocks = new block[nsets * assoc];
+	c->policy = policy;
+	c->access = find_accessor (policy, nsets, assoc, blocksize);
+	c->repl = policy->make (nsets, assoc);
+	c->repl->SetGeometry (blocksize, set_shift);
+	c->set_shift = set_shift;
+	c->nsets = nsets;
+	c->assoc = assoc;
+	c->blocksize = blocksize;
+	c->offset_bits = lg2 (blocksize);
+	c->modulo = nsets & (nsets - 1);
+	c->index_bits = c->modulo ? 0 : lg2 (nsets);
+	c->tagshiftbits = c->offset_bits + c->index_bits;
+	c->index_mask = c->modulo ? 0 : nsets - 1;
+	c->misses = 0;
+	c->accesses = 0;
+	c->random_counter = 0;
+	memset (c->counts, 0, sizeof (c->counts));
+}
+
+// save the contents of a cache and its replacement policy to a checkpoint,
+// or with restore read them back into a cache made by init_cache with the
+// same parameters
+
+void checkpoint_cache (FILE *f, cache *c, bool restore) {
+	CheckpointIO (f, restore, c->sets, c->nsets * sizeof (set));
+	CheckpointIO (f, restore, c->tags, (size_t) c->nsets * c->tag_stride * sizeof (unsigned long long int));
+	CheckpointIO (f, restore, c->blocks, c->nsets * c->assoc * sizeof (block));
+	CheckpointIO (f, restore, &c->misses, sizeof (c->misses));
+	CheckpointIO (f, restore, &c->accesses, sizeof (c->accesses));
+	CheckpointIO (f, restore, &c->random_counter, sizeof (c->random_counter));
+	CheckpointIO (f, restore, c->counts, sizeof (c->counts));
+	c->repl->Checkpoint (f, restore);
+}
+
+bool cache_access (cache *c, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core, unsigned long long int *writeback_address = NULL) {
+	return c->access (c, address, pc, size, op, core, writeback_address);
+}
+
+// access the memory, returning an integer that has:
+// bit 0 set if there is a miss in L1
+// bit 1 set if there is a miss in L2
+// bit 2 set if there is a miss in L3
+
+// private L1 and L2, shared L3
+
+unsigned int memory_access (cache **L1, cache **L2, cache *L3, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core) {
+	// access the memory hierarchy, returning latency of access
+	unsigned int miss = 0;
+	// unsigned long long int writeback_address;
+	if (L3) {
+		// L3 shared between everyone
+		bool missL3 = cache_access (L3, address, pc, size, op, core, NULL);
+		if (missL3) miss |= 4;
+	}
+	return miss;
+}
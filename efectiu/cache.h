@@ -0,0 +1,98 @@
+// quick and dirty cache simulation
+
+#include "policy.h"
+
+#define MAX_SETS	(1<<19)
+#define MAX_ASSOC	64	// as many ways as a set's masks have bits
+#define WORDSIZE	4
+
+#define DAN_IREAD       0
+#define DAN_DREAD       1
+#define DAN_WRITE       2
+#define DAN_BRTAKEN     3
+#define DAN_BRUNTAKEN   4
+#define DAN_BRIND       5
+#define DAN_WRITEBACK   6
+#define DAN_PREFETCH	7
+#define DAN_MAX		8
+
+#define OP_READ		DAN_DREAD
+#define OP_IREAD	DAN_IREAD
+#define OP_WRITE	DAN_WRITE
+#define OP_WRITEBACK	DAN_WRITEBACK
+
+// what is known about a block besides its tag, valid and dirty bits.  none
+// of it is needed to look a block up, so it is kept apart from the sets.
+
+struct block {
+	unsigned long long int filling_pc; // pc that filled this block
+	int offset; // offset of *byte* that caused this line to be filled
+
+	block (void) {
+		filling_pc = 0;
+		offset = 0;
+	}
+};
+
+// a set's tags are side by side in the cache's tags array, tag_stride of
+// them per set, so that a 16-way lookup reads two cache lines.  the valid
+// and dirty bits of its blocks are masks with bit i for way i.  a set is
+// entirely valid once valid_mask has all assoc bits set.
+
+typedef unsigned long long int waymask;
+
+struct set {
+	waymask	valid_mask, dirty_mask;
+
+	set (void) {
+		valid_mask = 0;
+		dirty_mask = 0;
+	}
+};
+
+// the mask of a set's assoc ways, for assoc from 1 to 64
+
+static inline waymask all_ways (int assoc) {
+	return (2ull << (assoc - 1)) - 1;
+}
+
+// with a power of two sets, the set of a block is its low index_bits
+// after set_shift and the tag the rest; with any other number the set is
+// the block modulo nsets and the tag the quotient.
+
+struct cache {
+	int	nsets, assoc, blocksize, set_shift;
+	int	offset_bits, index_bits, tagshiftbits;
+	unsigned int index_mask;
+	bool	modulo;		// nsets isn't a power of two
+	unsigned long long misses, accesses;
+	unsigned int random_counter; // picks victims for the random policy
+	set	*sets;
+	int	tag_stride;	// assoc rounded up to a multiple of 4
+	unsigned long long int *tags;	// tags[set*tag_stride+way]
+	block	*blocks;	// blocks[set*assoc+way]
+	long long int counts[DAN_MAX];
+
+	const policy_info *policy;
+	CACHE_REPLACEMENT_STATE *repl;
+	cache_access_fn access;	// cache_access_t () for the policy and geometry
+
+	cache (void) {
+		misses = 0;
+		accesses = 0;
+		index_mask = 0;
+		repl = NULL;
+	}
+};
+
+// the set address goes in
+
+static inline unsigned int cache_set (const cache *c, unsigned long long int address) {
+	unsigned long long int b = (address >> c->offset_bits) >> c->set_shift;
+	return c->modulo ? b % c->nsets : b & c->index_mask;
+}
+
+void init_cache (cache *c, int nsets, int assoc, int blocksize, const policy_info *policy, int set_shift);
+bool cache_access (cache *c, unsigned long long int address, unsigned long long int, unsigned int, int op, unsigned int core);
+void checkpoint_cache (FILE *f, cache *c, bool restore);
+unsigned int memory_access (cache **l1, cache **l2, cache *l3, unsigned long long int address, unsigned long long int, unsigned int, int op, unsigned int);
@@ -0,0 +1,202 @@
+// the body of cache_access (), as a template that each policy instantiates
+// for itself in its policy_*.cpp (see REGISTER_POLICY in policy.h)
+
+#ifndef __CACHE_ACCESS_H
+#define __CACHE_ACCESS_H
+
+#include <stdio.h>
+#include <assert.h>
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+static inline void place (cache *c, unsigned long long int pc, unsigned int set, block *b, int offset) {
+	// which pc filled this block
+
+	b->filling_pc = pc;
+
+	// which *byte* offset filled this block
+
+	b->offset = offset;
+}
+
+// index of the first of a set's assoc tags that is equal to tag, or -1.
+// tags past assoc are compared too but masked off; a set always has a
+// multiple of 4 of them.  it stops at the first group of tags with a match.
+// like the loop this replaces, it doesn't look at the valid bits.
+
+static inline int find_tag (const unsigned long long int *tags, int assoc, unsigned long long int tag) {
+	waymask match = 0;
+#if defined(__AVX2__)
+	__m256i t = _mm256_set1_epi64x (tag);
+	for (int i=0; i<assoc; i+=4) {
+		__m256i e = _mm256_cmpeq_epi64 (_mm256_load_si256 ((const __m256i *) &tags[i]), t);
+		match |= (waymask) _mm256_movemask_pd (_mm256_castsi256_pd (e)) << i;
+		if (match) break;
+	}
+#elif defined(__SSE2__)
+	// SSE2 only compares 32 bits at a time; a tag matches when both of
+	// its halves do
+	__m128i t = _mm_set1_epi64x (tag);
+	for (int i=0; i<assoc; i+=2) {
+		__m128i e = _mm_cmpeq_epi32 (_mm_load_si128 ((const __m128i *) &tags[i]), t);
+		e = _mm_and_si128 (e, _mm_shuffle_epi32 (e, _MM_SHUFFLE (2,3,0,1)));
+		match |= (waymask) _mm_movemask_pd (_mm_castsi128_pd (e)) << i;
+		if (match) break;
+	}
+#else
+	for (int i=0; i<assoc; i++) if (tags[i] == tag) match |= 1ull << i;
+#endif
+	match &= all_ways (assoc);
+	return match ? __builtin_ctzll (match) : -1;
+}
+
+static inline waymask set_bit (waymask m, int i, bool on) {
+	return on ? m | (1ull << i) : m & ~(1ull << i);
+}
+
+// what a policy's hooks are told about the access being simulated
+
+struct cache_op {
+	unsigned long long int address, pc, tag;
+	unsigned int set, core;
+	AccessTypes at;
+};
+
+// a policy for cache_access_t is a type with two hooks, both told the
+// cache's associativity.  victim () picks the way to replace in a set with
+// no invalid blocks, or -1 to bypass the cache.  update () is told about
+// every hit and every fill.
+
+// LRU, kept in the replacement state's packed stacks so that policies
+// that fall back on LRU order see the same one
+
+struct lru_hooks {
+	static inline int victim (cache *c, int assoc, const cache_op *o) {
+		if (assoc > LRU_MAX_ASSOC) return lru_wide_victim (&c->repl->lruWide[o->set * assoc], assoc);
+		return lru_victim (c->repl->lru[o->set], assoc);
+	}
+	static inline void update (cache *c, int assoc, int way, bool hit, const cache_op *o) {
+		if (assoc > LRU_MAX_ASSOC) lru_wide_touch (&c->repl->lruWide[o->set * assoc], assoc, way);
+		else c->repl->lru[o->set] = lru_touch (c->repl->lru[o->set], way);
+	}
+};
+
+struct random_hooks {
+	static inline int victim (cache *c, int assoc, const cache_op *o) {
+		return (c->random_counter++) % assoc;
+	}
+	static inline void update (cache *c, int assoc, int way, bool hit, const cache_op *o) { }
+};
+
+// whatever the replacement state P, a subclass of CACHE_REPLACEMENT_STATE,
+// implements.  the calls name P's methods, so they aren't virtual and can
+// be inlined.  it isn't told about hits by writebacks.
+
+template <class P>
+struct repl_hooks {
+	static inline int victim (cache *c, int assoc, const cache_op *o) {
+		return ((P *) c->repl)->P::GetVictimInSet (o->core, o->set, NULL, assoc, o->pc, o->address, o->at);
+	}
+	static inline void update (cache *c, int assoc, int way, bool hit, const cache_op *o) {
+		if (hit && o->at == ACCESS_WRITEBACK) return;
+		LINE_STATE ls;
+		ls.tag = o->tag;
+		((P *) c->repl)->P::UpdateReplacementState (o->set, way, &ls, o->core, o->pc, o->at, hit);
+	}
+};
+
+// access a cache, return true for miss, false for hit.  ASSOC and
+// BLOCKSIZE are the cache's geometry, or 0 to read it from the cache; with
+// them known at compile time the tag match and the address arithmetic
+// unroll and fold away.  POW2SETS says the cache has a power of two sets,
+// so the set index is a mask; otherwise the cache says how to index it.
+
+#define check_writeback(b) { if (writeback_address && ((s->valid_mask & s->dirty_mask) >> (b) & 1)) *writeback_address = (t[(b)] * c->nsets + o.set) << offset_bits; }
+
+// fill way b with the block being accessed
+
+#define fill(b) { \
+	t[(b)] = o.tag; \
+	s->valid_mask |= 1ull << (b); \
+	s->dirty_mask = set_bit (s->dirty_mask, (b), o.at == ACCESS_STORE || o.at == ACCESS_WRITEBACK); \
+	place (c, pc, o.set, &v[(b)], offset); }
+
+template <class policy, int ASSOC, int BLOCKSIZE, bool POW2SETS>
+bool cache_access_t (cache *c, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core, unsigned long long int *writeback_address) {
+	const int assoc = ASSOC ? ASSOC : c->assoc;
+	const int blocksize = BLOCKSIZE ? BLOCKSIZE : c->blocksize;
+	const int offset_bits = BLOCKSIZE ? __builtin_ctz (BLOCKSIZE) : c->offset_bits;
+	const int tag_stride = ASSOC ? (ASSOC + 3) & ~3 : c->tag_stride;
+	cache_op o;
+	c->counts[op]++;
+	int i;
+	unsigned int offset = address & (blocksize - 1);
+	unsigned long long int block_addr = address >> offset_bits;
+	o.address = address;
+	o.pc = pc;
+	o.core = core;
+
+	// note this doesn't generate the right tag if we have a non-zero set shift
+	// we *do* need the right tag value for things like the sampler to work
+	// because the sampler recontstructs the physical address from the tag & index
+
+	if (POW2SETS || !c->modulo) {
+		o.set = (block_addr >> c->set_shift) & c->index_mask;
+		o.tag = block_addr >> c->index_bits;
+	} else {
+		o.set = (block_addr >> c->set_shift) % c->nsets;
+		o.tag = block_addr / c->nsets;
+	}
+
+	c->accesses++;
+	struct set *s = &c->sets[o.set];
+	unsigned long long int *t = &c->tags[o.set * tag_stride];
+	block *v = &c->blocks[o.set * assoc];
+	if (writeback_address) *writeback_address = 0;
+	switch (op) {
+		case DAN_PREFETCH: o.at = ACCESS_PREFETCH; break;
+		case DAN_DREAD: o.at = ACCESS_LOAD; break;
+		case DAN_WRITE: o.at = ACCESS_STORE; break;
+		case DAN_WRITEBACK: o.at = ACCESS_WRITEBACK; break;
+		case DAN_IREAD: o.at = ACCESS_IFETCH; break;
+		default: o.at = ACCESS_LOAD;
+		printf ("op is %d!\n", op); fflush (stdout);
+		assert (0);
+	}
+	
+	// tag match?
+
+	i = find_tag (t, assoc, o.tag);
+	if (i >= 0) {
+		if (o.at == ACCESS_STORE || o.at == ACCESS_WRITEBACK) s->dirty_mask |= 1ull << i;
+		policy::update (c, assoc, i, true, &o);
+		return false;
+	}
+	c->misses++;
+
+	// a miss.
+	// find a block to replace: the first invalid one, or if there is no
+	// invalid block, whichever the policy picks.  -1 means bypass.
+
+	if (s->valid_mask != all_ways (assoc))
+		i = __builtin_ctzll (~s->valid_mask);
+	else
+		i = policy::victim (c, assoc, &o);
+	if (i != -1) {
+		assert (i >= 0 && i < assoc);
+		check_writeback (i);
+		fill (i);
+		policy::update (c, assoc, i, false, &o);
+	}
+	// only count as a miss if the block is not a writeback block or prefetch
+	return (o.at != ACCESS_WRITEBACK) && (o.at != ACCESS_PREFETCH);
+}
+
+#undef check_writeback
+#undef fill
+
+#endif
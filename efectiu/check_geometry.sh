@@ -0,0 +1,38 @@
+#!/bin/bash
+# Run every replacement policy over a few million instructions of one trace
+# in LLCs of shapes other than the default 4MB of 16 ways, and fail if any
+# run crashes.  The wide shapes catch per-set and sampler state that is
+# sized for 16 ways but indexed by the cache's way.  Policies that need a
+# power of two ways are run at 12 ways apart, and have to refuse it.
+trace=${1:-~/tracesWorking/429.mcf-184B.trace.gz}
+export DAN_WARM_INST=1000000 DAN_MAX_INST=5000000
+all=lru,plru,random,bip,dip,srrip,drrip,ship,deadblock,perceptron
+any=lru,random,bip,dip,srrip,drrip,ship,deadblock
+status=0
+
+run () {
+	echo "$*"
+	if ! env "$@" ./efectiu "$trace" > /dev/null 2> check_geometry.err; then
+		tail -1 check_geometry.err
+		status=1
+	fi
+}
+
+run DAN_POLICY=perceptron DAN_LLC_ASSOC=32
+run DAN_POLICIES=$all DAN_LLC_ASSOC=8
+run DAN_POLICIES=$all DAN_LLC_ASSOC=32
+run DAN_POLICIES=$all DAN_LLC_ASSOC=64
+run DAN_POLICIES=$all DAN_LLC_SIZE=6291456
+run DAN_POLICIES=$any DAN_LLC_SIZE=3145728 DAN_LLC_ASSOC=12
+
+for p in plru perceptron; do
+	echo "DAN_POLICY=$p DAN_LLC_SIZE=3145728 DAN_LLC_ASSOC=12 is refused"
+	DAN_POLICY=$p DAN_LLC_SIZE=3145728 DAN_LLC_ASSOC=12 ./efectiu "$trace" > /dev/null 2> check_geometry.err
+	if [ $? -ne 1 ]; then
+		tail -1 check_geometry.err
+		status=1
+	fi
+done
+rm -f check_geometry.err
+[ $status -eq 0 ] && echo "all geometries ran"
+exit $status
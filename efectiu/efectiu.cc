@@ -0,0 +1,824 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+#include <math.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+using namespace std;
+
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "stackdist.h"
+#include "mrc.h"
+#include "shard.h"
+#include "min.h"
+#include "trace.h"
+#include "model.h"
+
+#define N	1000
+
+// L1 private caches: 32KB
+
+// L3 shared cache: 4MB by default; DAN_LLC_SIZE, DAN_LLC_ASSOC and
+// DAN_LLC_BLOCKSIZE change it
+
+#ifndef LLC_CAPACITY
+#define LLC_CAPACITY	(4 * 1024 * 1024)
+#endif
+#define LLC_BLOCKSIZE	64
+#define LLC_ASSOC	16
+
+#define MAX_CORES	16
+#define MAX_THREADS	256
+#define MAX_POLICIES	16
+
+// one last-level cache per policy being simulated; every cache sees the same accesses
+
+cache LLC[MAX_POLICIES];
+int npolicies = 1;
+const policy_info *policies[MAX_POLICIES];
+tracereader *readers[MAX_THREADS];
+trace *traces[MAX_THREADS];
+unsigned long long int 
+	l3_misses[MAX_POLICIES][MAX_CORES], 
+	l3_misses_at_warming[MAX_POLICIES][MAX_CORES],
+	l3_accesses = 0;
+int ncores, nthreads;
+long long int llc_capacity = LLC_CAPACITY;
+int llc_assoc = LLC_ASSOC, llc_blocksize = LLC_BLOCKSIZE, llc_nsets;
+bool warming = true;
+
+int tracecount = 0;
+
+long long int last_insts[MAX_THREADS];
+
+unsigned long long int cycles[MAX_THREADS], cycles_at_warming[MAX_THREADS], insts_at_warming[MAX_THREADS];
+
+void print_stats (void);
+double getipc (const char *);
+int dan_set_shift = 0, dan_warm_inst = 500000000;
+const char *dan_policy = "lru";
+int dan_trace_buffers = 0, dan_trace_chunk = 4;
+int dan_stackdist = 0;
+stackdist sd;
+int dan_mrc = 0;
+mrc mr;
+int dan_set_sample = 0;
+unsigned char *set_live;		// whether each LLC set is simulated
+unsigned long long int *set_misses;	// set_misses[(p*ncores+core)*nsets+set] since warming
+int dan_shards = 0, dan_shard_sync = 0;
+int dan_hugepages = 0;
+bool dan_converge_on = false;
+double dan_converge = 0;
+long long int dan_converge_window = 10000000;
+char *dan_min_trace = NULL;
+bool min_recording = false;
+shardset shards;
+unsigned long long int 
+	//dan_max_inst = 1000000000, 
+	dan_max_inst = 1000000000, 
+	//dan_max_cycle = 1000000000000ull;
+	dan_max_cycle = 1;
+unsigned long long int dan_skip_inst = 0;
+char *dan_checkpoint = NULL, *dan_restore = NULL;
+long long int iterations = 0;
+char benchmark_name[1000];
+
+#define GET_PARAM(name,var) { \
+                char *s = getenv (name); \
+                if (!s) { if (0) fprintf (stderr, "warning: parameter %s not found in environment\n", name);} \
+                else { sscanf (s, "%d", &var); fprintf (stderr, "%s=%d\n", name, var); } }
+
+#define GET_LL_PARAM(name,var) { \
+                char *s = getenv (name); \
+                if (!s) { if (0) fprintf (stderr, "warning: parameter %s not found in environment\n", name);} \
+                else { sscanf (s, "%lld", &var); fprintf (stderr, "%s=%lld\n", name, var); } }
+
+FILE *traceout = NULL;
+
+// tournament tree over the threads' next records, so picking the thread
+// whose record comes first and replacing that record are O(log threads).
+// tourney[1] is the root and thread j's leaf is tourney[tsize+j]; every
+// other node holds whichever of its two children is earlier, with ties
+// going to the lower-numbered thread.  -1 is an empty leaf.
+
+int tsize, tourney[2*MAX_THREADS];
+
+static inline int earlier (int a, int b) {
+	if (a < 0) return b;
+	if (b < 0) return a;
+	if (cycles[b] < cycles[a]) return b;
+	if (cycles[a] < cycles[b]) return a;
+	return a < b ? a : b;
+}
+
+void tourney_update (int thread) {
+	for (int i=(tsize+thread)/2; i; i/=2) tourney[i] = earlier (tourney[2*i], tourney[2*i+1]);
+}
+
+void tourney_init (void) {
+	for (tsize=1; tsize<nthreads; tsize*=2);
+	for (int j=0; j<tsize; j++) tourney[tsize+j] = j < nthreads ? j : -1;
+	for (int i=tsize-1; i; i--) tourney[i] = earlier (tourney[2*i], tourney[2*i+1]);
+}
+
+// with a sharded LLC the misses are counted by the shard threads; wait for
+// them to catch up and bring l3_misses up to date
+
+void collect_shards (void) {
+	if (!dan_shards) return;
+	shard_drain (&shards);
+	shard_misses (&shards, &l3_misses[0][0]);
+}
+
+// a checkpoint is this header, then the statistics arrays, the LLCs, the
+// stack distance profile, miss ratio curves and sampled sets' misses if
+// there are any, and where each trace reader is.  the header
+// describes the simulation so a checkpoint is only restored into one set up
+// the same way.
+
+#define CHECKPOINT_MAGIC	"efctckpt"
+#define CHECKPOINT_VERSION	13
+
+struct checkpointheader {
+	char	magic[8];
+	int	version, nsets, assoc, blocksize, set_shift, stackdist, mrc, set_select, set_sample;
+	int	npolicies;
+	char	policies[MAX_POLICIES][32];	// their names
+	int	nthreads;
+	char	traces[MAX_THREADS][100];	// trace names without directory or .gz, .flat, .pack
+	long long int iterations;
+};
+
+// the name of a trace without its directory or format suffix, so that a
+// checkpoint from a .gz trace can be restored on its .pack version
+
+void trace_stem (char *stem, const char *name) {
+	const char *slash = strrchr (name, '/'), *base = slash ? slash + 1 : name;
+	const char *dot = strrchr (base, '.');
+	size_t n = strlen (base);
+	if (dot && (!strcmp (dot, ".gz") || !strcmp (dot, ".flat") || !strcmp (dot, ".pack"))) n = dot - base;
+	if (n > 99) n = 99;
+	memset (stem, 0, 100);
+	memcpy (stem, base, n);
+}
+
+void make_checkpointheader (checkpointheader *h) {
+	memset (h, 0, sizeof (checkpointheader));
+	memcpy (h->magic, CHECKPOINT_MAGIC, sizeof (h->magic));
+	h->version = CHECKPOINT_VERSION;
+	h->nsets = LLC[0].nsets;
+	h->assoc = LLC[0].assoc;
+	h->blocksize = LLC[0].blocksize;
+	h->set_shift = LLC[0].set_shift;
+	h->stackdist = dan_stackdist;
+	h->mrc = dan_mrc;
+	h->set_select = CACHE_REPLACEMENT_STATE::setSelect;
+	h->set_sample = dan_set_sample;
+	h->npolicies = npolicies;
+	for (int p=0; p<npolicies; p++) strncpy (h->policies[p], policies[p]->name, sizeof (h->policies[p]) - 1);
+	h->nthreads = nthreads;
+	for (int j=0; j<nthreads; j++) trace_stem (h->traces[j], readers[j]->getname ());
+	h->iterations = iterations;
+}
+
+// save or restore everything after the header
+
+void checkpoint_state (FILE *f, bool restore) {
+	CheckpointIO (f, restore, l3_misses, sizeof (l3_misses));
+	CheckpointIO (f, restore, l3_misses_at_warming, sizeof (l3_misses_at_warming));
+	CheckpointIO (f, restore, last_insts, sizeof (last_insts));
+	CheckpointIO (f, restore, cycles, sizeof (cycles));
+	CheckpointIO (f, restore, cycles_at_warming, sizeof (cycles_at_warming));
+	CheckpointIO (f, restore, insts_at_warming, sizeof (insts_at_warming));
+	for (int p=0; p<npolicies; p++) checkpoint_cache (f, &LLC[p], restore);
+	if (dan_stackdist) checkpoint_stackdist (f, &sd, restore);
+	if (dan_mrc) checkpoint_mrc (f, &mr, restore);
+	if (dan_set_sample) CheckpointIO (f, restore, set_misses, npolicies * ncores * llc_nsets * sizeof (unsigned long long int));
+	for (int j=0; j<nthreads; j++) readers[j]->checkpoint (f, restore);
+}
+
+void save_checkpoint (const char *name) {
+	FILE *f = fopen (name, "w");
+	if (!f) {
+		perror (name);
+		exit (1);
+	}
+	checkpointheader h;
+	make_checkpointheader (&h);
+	CheckpointIO (f, false, &h, sizeof (h));
+	checkpoint_state (f, false);
+	if (fclose (f)) {
+		perror (name);
+		exit (1);
+	}
+	fprintf (stderr, "saved checkpoint %s\n", name);
+}
+
+void restore_checkpoint (const char *name) {
+	FILE *f = fopen (name, "r");
+	if (!f) {
+		perror (name);
+		exit (1);
+	}
+	checkpointheader h, mine;
+	make_checkpointheader (&mine);
+	CheckpointIO (f, true, &h, sizeof (h));
+	mine.iterations = h.iterations;
+	if (memcmp (h.magic, CHECKPOINT_MAGIC, sizeof (h.magic)) || h.version != CHECKPOINT_VERSION) {
+		fprintf (stderr, "%s: not a checkpoint\n", name);
+		exit (1);
+	}
+	if (memcmp (&h, &mine, sizeof (h))) {
+		fprintf (stderr, "%s: checkpoint is of different traces, policies or cache parameters\n", name);
+		exit (1);
+	}
+	checkpoint_state (f, true);
+	fclose (f);
+	iterations = h.iterations;
+	warming = false;
+	fprintf (stderr, "restored checkpoint %s\n", name);
+}
+
+// record how many instructions thread j has reached and stop warming if
+// that is past DAN_WARM_INST
+
+void check_warming (int j) {
+	last_insts[j] = traces[j]->instr;// readers[j]->get_icount();
+	if (warming && last_insts[j] > dan_warm_inst) {
+		warming = false;
+		fprintf (stderr, "stopped warming at thread %d with %lld instructions...\n", j, last_insts[j]);
+		fflush (stderr);
+		collect_shards ();
+		memcpy (l3_misses_at_warming, l3_misses, sizeof (l3_misses));
+		if (dan_stackdist) stackdist_warmed (&sd);
+		if (dan_mrc) mrc_warmed (&mr);
+		memcpy (cycles_at_warming, cycles, sizeof (cycles));
+		for (int z=0; z<nthreads; z++) {
+			insts_at_warming[z] = readers[z]->get_icount();
+		}
+		if (dan_checkpoint) save_checkpoint (dan_checkpoint);
+	}
+}
+
+// DAN_CONVERGE's monitor.  once warming is over, each core's instructions
+// are cut into windows of DAN_CONVERGE_WINDOW, and how much the MPKIs of
+// the windows spread gives the standard error of the MPKI measured so far,
+// by the method of batch means.  the run can stop when that is small enough
+// for every policy and core, or when every trace has gone all the way
+// around since warming, after which it would only repeat itself.
+
+#define CONVERGE_MIN_WINDOWS	5
+
+struct convergence {
+	bool	started;
+	long long int start_insts[MAX_THREADS];		// each thread's instructions when measuring began
+	long long int window_insts[MAX_CORES];		// and at the start of each core's window
+	unsigned long long int window_misses[MAX_POLICIES][MAX_CORES];
+	int	windows[MAX_CORES];
+	double	sum[MAX_POLICIES][MAX_CORES], sq[MAX_POLICIES][MAX_CORES];	// of the windows' MPKIs
+} conv;
+
+// whether the run can stop after thread j's latest record, saying why if so
+
+bool check_convergence (int j) {
+	if (!conv.started) {
+		conv.started = true;
+		for (int z=0; z<nthreads; z++) conv.start_insts[z] = last_insts[z];
+		for (int i=0; i<ncores; i++) conv.window_insts[i] = last_insts[i];
+		collect_shards ();
+		memcpy (conv.window_misses, l3_misses, sizeof (conv.window_misses));
+		return false;
+	}
+	if (j >= ncores || last_insts[j] - conv.window_insts[j] < dan_converge_window) return false;
+
+	// core j finished a window
+
+	collect_shards ();
+	for (int p=0; p<npolicies; p++) {
+		double mpki = 1000.0 * (l3_misses[p][j] - conv.window_misses[p][j]) / (double) (last_insts[j] - conv.window_insts[j]);
+		conv.sum[p][j] += mpki;
+		conv.sq[p][j] += mpki * mpki;
+		conv.window_misses[p][j] = l3_misses[p][j];
+	}
+	conv.window_insts[j] = last_insts[j];
+	conv.windows[j]++;
+
+	int z;
+	for (z=0; z<nthreads; z++) {
+		long long int lap = readers[z]->get_lap ();
+		if (!lap || last_insts[z] - conv.start_insts[z] < lap) break;
+	}
+	if (z == nthreads) {
+		printf ("every trace has repeated since warming; stopping\n");
+		return true;
+	}
+
+	// the widest 95% confidence interval relative to its MPKI
+
+	double worst = 0;
+	for (int i=0; i<ncores; i++) {
+		int k = conv.windows[i];
+		if (k < CONVERGE_MIN_WINDOWS) return false;
+		for (int p=0; p<npolicies; p++) {
+			double mean = conv.sum[p][i] / k, var = (conv.sq[p][i] - k * mean * mean) / (k - 1);
+			double half = var > 0 ? 1.96 * sqrt (var / k) : 0;
+			if (half > worst * mean) worst = half / mean;
+		}
+	}
+	if (worst <= dan_converge) {
+		printf ("MPKI converged to within %0.2f%% after %lld instructions; stopping\n", 100 * worst, last_insts[j] - conv.start_insts[j]);
+		return true;
+	}
+	return false;
+}
+
+// the policy named by the first n characters of name, or a list of the
+// policies and an exit if there is none
+
+const policy_info *get_policy (const char *name, size_t n) {
+	char buf[32];
+	if (n >= sizeof (buf)) n = sizeof (buf) - 1;
+	memcpy (buf, name, n);
+	buf[n] = 0;
+	const policy_info *p = find_policy (buf);
+	if (!p) {
+		fprintf (stderr, "unknown policy \"%s\"; the policies are:\n", buf);
+		list_policies (stderr);
+		exit (1);
+	}
+	return p;
+}
+
+int main (int argc, char *argv[]) {
+	int i;
+
+	assert (argc >= 2);
+	ncores = argc - 1;
+	nthreads = ncores;
+	if (ncores > MAX_CORES) ncores = MAX_CORES;
+
+	// initialize private caches and trace readers
+
+	// DAN_TRACE_BUFFERS > 0 inflates each trace on its own thread into
+	// that many buffers of DAN_TRACE_CHUNK megabytes
+
+	GET_PARAM ("DAN_TRACE_BUFFERS", dan_trace_buffers);
+	GET_PARAM ("DAN_TRACE_CHUNK", dan_trace_chunk);
+
+	// DAN_SKIP_INST starts every trace at that instruction, using the
+	// traceindex sidecar if there is one
+
+	GET_LL_PARAM ("DAN_SKIP_INST", dan_skip_inst);
+
+	// DAN_CHECKPOINT=file saves the whole state of the simulation to file
+	// when the warmup ends.  DAN_RESTORE=file starts measuring from such a
+	// checkpoint instead of warming up, picking up every trace where the
+	// checkpointed run left it
+
+	dan_checkpoint = getenv ("DAN_CHECKPOINT");
+	dan_restore = getenv ("DAN_RESTORE");
+	if (dan_checkpoint) fprintf (stderr, "DAN_CHECKPOINT=%s\n", dan_checkpoint);
+	if (dan_restore) fprintf (stderr, "DAN_RESTORE=%s\n", dan_restore);
+	for (i=0; i<nthreads; i++) {
+		readers[i] = new tracereader (argv[i+1]);
+		if (dan_skip_inst && !dan_restore) readers[i]->seek (dan_skip_inst);
+	}
+
+	// DAN_POLICY names the replacement policy of the LLC, e.g. "ship"; see
+	// policy.h.  the default is LRU.
+
+	char *s = getenv ("DAN_POLICY");
+	if (s) {
+		dan_policy = s;
+		fprintf (stderr, "DAN_POLICY=%s\n", s);
+	}
+	policies[0] = get_policy (dan_policy, strlen (dan_policy));
+
+	// DAN_POLICIES is a list like "lru,dip,ship" of policies to simulate
+	// side by side on a single pass through the traces, overriding DAN_POLICY
+
+	s = getenv ("DAN_POLICIES");
+	if (s) {
+		fprintf (stderr, "DAN_POLICIES=%s\n", s);
+		npolicies = 0;
+		for (char *p = s; *p; ) {
+			size_t n = strcspn (p, ", ");
+			if (!n) { p++; continue; } // skip separators
+			if (npolicies == MAX_POLICIES) {
+				fprintf (stderr, "DAN_POLICIES: at most %d policies\n", MAX_POLICIES);
+				exit (1);
+			}
+			policies[npolicies++] = get_policy (p, n);
+			p += n;
+		}
+		assert (npolicies > 0);
+	}
+	GET_LL_PARAM ("DAN_MAX_INST", dan_max_inst);
+	GET_LL_PARAM ("DAN_MAX_CYCLE", dan_max_cycle);
+	GET_PARAM ("DAN_WARM_INST", dan_warm_inst);
+
+	// DAN_CONVERGE=e stops the run early once every MPKI is within a
+	// relative error e, e.g. 0.01, with 95% confidence, judged from
+	// windows of DAN_CONVERGE_WINDOW instructions, or once every trace
+	// has repeated since warming
+
+	s = getenv ("DAN_CONVERGE");
+	if (s) {
+		dan_converge_on = true;
+		dan_converge = atof (s);
+		fprintf (stderr, "DAN_CONVERGE=%g\n", dan_converge);
+	}
+	GET_LL_PARAM ("DAN_CONVERGE_WINDOW", dan_converge_window);
+	if (dan_converge_window <= 0) {
+		fprintf (stderr, "DAN_CONVERGE_WINDOW: a positive number of instructions\n");
+		exit (1);
+	}
+	GET_PARAM ("DAN_SET_SHIFT", dan_set_shift);
+
+	// DAN_LLC_SIZE=bytes, DAN_LLC_ASSOC=ways and DAN_LLC_BLOCKSIZE=bytes
+	// give the LLC's geometry.  the blocks are a power of two bytes, but
+	// the number of sets needn't be; then a block's set is its address
+	// modulo the number of sets
+
+	GET_LL_PARAM ("DAN_LLC_SIZE", llc_capacity);
+	GET_PARAM ("DAN_LLC_ASSOC", llc_assoc);
+	GET_PARAM ("DAN_LLC_BLOCKSIZE", llc_blocksize);
+	if (llc_assoc < 1 || llc_assoc > MAX_ASSOC || llc_blocksize < 1 || (llc_blocksize & (llc_blocksize - 1))
+		|| llc_capacity <= 0 || llc_capacity % ((long long int) llc_assoc * llc_blocksize)) {
+		fprintf (stderr, "the LLC has to be whole sets of 1 to %d ways of a power of two bytes\n", MAX_ASSOC);
+		exit (1);
+	}
+	llc_nsets = llc_capacity / ((long long int) llc_assoc * llc_blocksize);
+	for (int p=0; p<npolicies; p++) if (policies[p]->pow2assoc && (llc_assoc & (llc_assoc - 1))) {
+		fprintf (stderr, "%s needs a power of two ways, not %d\n", policies[p]->name, llc_assoc);
+		exit (1);
+	}
+
+	// DAN_HUGEPAGES=1 backs the replacement state with transparent huge
+	// pages, for big LLCs
+
+	GET_PARAM ("DAN_HUGEPAGES", dan_hugepages);
+	CACHE_REPLACEMENT_STATE::hugePages = dan_hugepages;
+
+	// DAN_SET_SELECT=strided, complement or random chooses the sampled and
+	// dueling sets of every policy that way instead of the policy's own
+
+	s = getenv ("DAN_SET_SELECT");
+	if (s) {
+		fprintf (stderr, "DAN_SET_SELECT=%s\n", s);
+		for (i=0; i<SETS_SCHEMES && strcmp (s, CACHE_REPLACEMENT_STATE::setSelectNames[i]); i++);
+		if (i == SETS_SCHEMES) {
+			fprintf (stderr, "DAN_SET_SELECT: one of strided, complement, random\n");
+			exit (1);
+		}
+		CACHE_REPLACEMENT_STATE::setSelect = i;
+	}
+
+	// DAN_SET_SAMPLE=n simulates only 1 in n of the LLC sets, n a power
+	// of two, and scales their misses up into an estimate, with a
+	// confidence interval, of the whole LLC's
+
+	GET_PARAM ("DAN_SET_SAMPLE", dan_set_sample);
+	if (dan_set_sample) {
+		if (dan_set_sample < 2 || (dan_set_sample & (dan_set_sample - 1)) || dan_set_sample > llc_nsets / 2 || llc_nsets % dan_set_sample) {
+			fprintf (stderr, "DAN_SET_SAMPLE: 1 in a power of two sets that divides the sets, leaving at least 2\n");
+			exit (1);
+		}
+		CACHE_REPLACEMENT_STATE::setSample = dan_set_sample;
+	}
+	s = getenv ("BENCHMARK_NAME");
+	if (s) strcpy (benchmark_name, s); else strcpy (benchmark_name, "unknown");
+
+	// initialize last-level caches
+
+	for (int p=0; p<npolicies; p++) init_cache (
+		&LLC[p], 	// pointer to last-level cache data structure
+		llc_nsets, 	// number of sets in last-level cache
+		llc_assoc, 	// last-level cache associativity
+		llc_blocksize, 	// last-level cache block size
+		policies[p], 	// last-level cache replacement policy
+		dan_set_shift);	// number of lower-order bits in set index to ignore; safe to set to 0 here
+
+	printf ("LLC %lld bytes, %d assoc\n", llc_capacity, llc_assoc);
+	if (LLC[0].modulo) printf ("LLC %d sets, indexed by modulo\n", llc_nsets);
+	if (dan_set_sample) {
+		int n = llc_nsets / dan_set_sample;
+		UINT32 *live = new UINT32[n];
+		CACHE_REPLACEMENT_STATE::ChooseSampledSets (llc_nsets, dan_set_sample, live);
+		set_live = new unsigned char[llc_nsets];
+		memset (set_live, 0, llc_nsets);
+		for (i=0; i<n; i++) set_live[live[i]] = 1;
+		delete[] live;
+		set_misses = new unsigned long long int[npolicies * ncores * llc_nsets];
+		memset (set_misses, 0, npolicies * ncores * llc_nsets * sizeof (unsigned long long int));
+		printf ("simulating 1 in %d sets\n", dan_set_sample);
+	}
+
+	// DAN_STACKDIST=n also profiles LRU stack distances to get LRU
+	// misses for every power-of-two number of sets up to n and up to
+	// STACKDIST_ASSOC (16) ways
+
+	GET_PARAM ("DAN_STACKDIST", dan_stackdist);
+	if (dan_stackdist) {
+		if (dan_stackdist < 0 || (dan_stackdist & (dan_stackdist - 1)) || dan_stackdist > MAX_SETS) {
+			fprintf (stderr, "DAN_STACKDIST: a power of two sets up to %d\n", MAX_SETS);
+			exit (1);
+		}
+		init_stackdist (&sd, dan_stackdist, llc_blocksize, dan_set_shift, ncores);
+	}
+
+	// DAN_MRC=n also simulates miniature caches of every policy on the
+	// accesses to 1 in n blocks, n a power of two, for a miss ratio curve
+	// of each policy from 1/16 to 16 times the LLC's capacity
+
+	GET_PARAM ("DAN_MRC", dan_mrc);
+	if (dan_mrc && dan_set_sample) {
+		fprintf (stderr, "DAN_MRC doesn't work with DAN_SET_SAMPLE\n");
+		exit (1);
+	}
+	if (dan_mrc) {
+		if (dan_mrc < 0 || (dan_mrc & (dan_mrc - 1))) {
+			fprintf (stderr, "DAN_MRC: sample 1 in a power of two blocks\n");
+			exit (1);
+		}
+		init_mrc (&mr, dan_mrc, policies, npolicies, llc_nsets, llc_assoc, llc_blocksize, dan_set_shift, ncores);
+	}
+
+	// DAN_SHARDS=n simulates the LLCs on n threads, thread i taking the
+	// sets whose index is i mod n.  DAN_SHARD_SYNC=k merges the policies'
+	// global tables across the threads every k accesses; 0 leaves each
+	// thread to learn from its own sets
+
+	GET_PARAM ("DAN_SHARDS", dan_shards);
+	GET_PARAM ("DAN_SHARD_SYNC", dan_shard_sync);
+	if (dan_shards < 0 || dan_shards > MAX_SHARDS) {
+		fprintf (stderr, "DAN_SHARDS: 1 to %d threads\n", MAX_SHARDS);
+		exit (1);
+	}
+	if (dan_shards) init_shards (&shards, LLC, npolicies, MAX_CORES, dan_shards, dan_shard_sync);
+	if (dan_shards && dan_set_sample) {
+		fprintf (stderr, "DAN_SET_SAMPLE doesn't work with DAN_SHARDS\n");
+		exit (1);
+	}
+	if (dan_shards && (dan_checkpoint || dan_restore)) {
+		fprintf (stderr, "checkpoints don't work with DAN_SHARDS\n");
+		exit (1);
+	}
+	if (dan_restore) restore_checkpoint (dan_restore);
+
+	// DAN_MIN_TRACE=file is the annotated access stream the min policies
+	// read.  if there is no such file, this run records its accesses and
+	// writes it at the end, counting them from where it starts
+
+	dan_min_trace = getenv ("DAN_MIN_TRACE");
+	if (dan_min_trace) fprintf (stderr, "DAN_MIN_TRACE=%s\n", dan_min_trace);
+	if (!dan_min_trace || !open_min (&min_oracle, dan_min_trace, LLC[0].offset_bits)) {
+		if (min_oracle.users) {
+			fprintf (stderr, "the min policies need DAN_MIN_TRACE naming a MIN trace; a run of any other policy with it set makes one\n");
+			exit (1);
+		}
+		if (dan_min_trace) {
+			start_min_record (&min_oracle, iterations);
+			min_recording = true;
+		}
+	}
+	if (min_oracle.users && dan_shards) {
+		fprintf (stderr, "the min policies don't work with DAN_SHARDS\n");
+		exit (1);
+	}
+	if (dan_trace_buffers) for (i=0; i<nthreads; i++) readers[i]->background (dan_trace_buffers, dan_trace_chunk << 20);
+
+	// prime the traces, or with a checkpoint pick up the records that
+	// were next when it was made
+
+	for (i=0; i<nthreads; i++) {
+		traces[i] = dan_restore ? readers[i]->current() : readers[i]->read();
+		assert (traces[i]);
+		cycles[i] = traces[i]->cycle;
+	}
+
+	// read a lot of traces
+	// currently, the trace reader just sets the number of cycles equal to the number of instructions in that thread.
+	// after the simulation is done we translate this to estimated cycles using misses and a linear model.
+	
+	tourney_init ();
+	int last_thread = -1;
+	for (;;) {
+
+		// see which trace comes first in terms of cycle count (i.e. instruction count for now)
+
+		int min_cycle_thread = tourney[1];
+
+		// note how far each thread has gotten and whether that ends the
+		// warmup.  only the thread we just read from can have changed.
+
+		if (last_thread == -1) {
+			for (int j=0; j<nthreads; j++) check_warming (j);
+		} else
+			check_warming (last_thread);
+
+		// make t point to the oldest trace
+
+		trace *t = traces[min_cycle_thread];
+
+		// figure out what kind of operation this is; if it is a
+		// branch then we don't need to know that.  if it is a iread
+		// or dread, or write, then we need it.
+
+		// put the core ID in the address so we have no coherence issues 
+
+		t->address &= 0x00ffffffffffffffull;
+		t->address |= (((unsigned long long) min_cycle_thread % MAX_CORES) << 56);
+
+		bool use_cache = true;
+		bool use_br = false;
+		switch (t->cmd) {
+			case DAN_IREAD: 
+			case DAN_PREFETCH:
+			case DAN_DREAD:
+			case DAN_WRITEBACK:
+			case DAN_WRITE: use_cache = true; break;
+			case DAN_BRTAKEN: 
+			case DAN_BRUNTAKEN: 
+			case DAN_BRIND:
+				assert (0);
+				use_cache = false; 
+				use_br = true; break;
+			default: assert (use_br && 0);
+		}
+		if (use_cache) {
+			// simulate memory access with this trace
+
+			min_oracle.now = iterations;
+			if (min_recording) min_record (&min_oracle, t->address);
+			if (dan_shards)
+				shard_access (&shards, t->address, t->pc, t->size, t->cmd, min_cycle_thread % MAX_CORES);
+			else if (dan_set_sample) {
+				// accesses to sets that aren't sampled go nowhere
+				unsigned int set = cache_set (&LLC[0], t->address);
+				unsigned int core = min_cycle_thread % MAX_CORES;
+				if (set_live[set]) for (int p=0; p<npolicies; p++) {
+					unsigned int miss;
+					miss = memory_access (NULL, NULL, &LLC[p], t->address, t->pc, t->size, t->cmd, core);
+					if (miss & 4) {
+						l3_misses[p][core]++;
+						if (!warming) set_misses[(p * ncores + core) * llc_nsets + set]++;
+					}
+				}
+			} else for (int p=0; p<npolicies; p++) {
+				unsigned int miss;
+				miss = memory_access (NULL, NULL, &LLC[p], t->address, t->pc, t->size, t->cmd, min_cycle_thread % MAX_CORES);
+				if (miss & 4) l3_misses[p][min_cycle_thread%MAX_CORES]++;
+			}
+			if (dan_stackdist) stackdist_access (&sd, t->address, t->cmd, min_cycle_thread % MAX_CORES);
+			if (dan_mrc) mrc_access (&mr, t->address, t->pc, t->size, t->cmd, min_cycle_thread % MAX_CORES);
+		}
+
+		// replace the oldest trace with a new trace from the same trace file
+
+		traces[min_cycle_thread] = readers[min_cycle_thread]->read();
+		cycles[min_cycle_thread] = traces[min_cycle_thread]->cycle;
+		tourney_update (min_cycle_thread);
+		last_thread = min_cycle_thread;
+		if (iterations && iterations % 100000000 == 0) {
+			printf ("core 0 icount = %lld\n", readers[0]->get_icount());
+			print_stats ();
+		}
+		iterations++;
+
+		// see if we are done in terms of getting to the maximum number of instructions for some thread.
+		// again, only the thread we just read from can have gotten there.
+
+		if (readers[min_cycle_thread]->get_icount() >= dan_max_inst) {
+			printf ("thread %d reached %lld instructions; stopping\n", min_cycle_thread, readers[min_cycle_thread]->get_icount());
+			break;
+		}
+		if (dan_converge_on && !warming && check_convergence (min_cycle_thread)) break;
+	}
+	if (dan_shards) close_shards (&shards);
+	print_stats ();
+	if (traceout) fclose (traceout);
+	//for (i=0; i<ncores; i++) delete readers[i];
+	if (min_recording) finish_min (&min_oracle);
+	return 0;
+}
+
+// the CPI of a trace with its model at mpi misses per instruction, or with
+// a default model if it has none
+
+double model_cpi (const model *m, double mpi) {
+#define L3_MISS_PENALTY	270
+	if (!m) return ( L3_MISS_PENALTY * mpi ) + 0.33333;
+	double mpki = 1000.0 * mpi;
+	return mpki * m->m + m->b;
+}
+
+// with DAN_SET_SAMPLE, the 95% confidence interval of core's misses since
+// warming under policy p.  the simulated sets are a simple random sample of
+// k of the LLC's N sets, so the N times their mean estimates the total, with
+// a variance of N^2 (1 - k/N) s^2 / k where s^2 is their sample variance.
+
+void set_sample_interval (int p, int core, double *lo, double *hi) {
+	unsigned long long int *m = &set_misses[(p * ncores + core) * llc_nsets];
+	int k = 0;
+	double sum = 0, sq = 0;
+	for (int s=0; s<llc_nsets; s++) if (set_live[s]) {
+		sum += m[s];
+		k++;
+	}
+	double mean = sum / k;
+	for (int s=0; s<llc_nsets; s++) if (set_live[s]) sq += (m[s] - mean) * (m[s] - mean);
+	double n = llc_nsets, var = n * n * (1 - k / n) * (sq / (k - 1)) / k;
+	double half = 1.96 * sqrt (var);
+	*lo = n * mean - half;
+	*hi = n * mean + half;
+	if (*lo < 0) *lo = 0;
+}
+
+void print_stats (void) {
+	int i;
+
+	collect_shards ();
+	for (int p=0; p<npolicies; p++) LLC[p].repl->PrintStats (cout);
+	unsigned long long int insts[MAX_CORES];
+	for (i=0; i<ncores; i++) insts[i] = last_insts[i]-insts_at_warming[i];
+	if (dan_stackdist) print_stackdist (&sd, insts);
+	if (dan_mrc) print_mrc (&mr, insts);
+	// estimate number of instructions executed so far using IPC from original simulations
+
+	double sum = 0.0;
+	for (i=0; i<ncores; i++)
+		sum += last_insts[i];
+
+	// compute estimated MPKIs
+
+	char hostname[100];
+	gethostname (hostname, 100);
+	printf ("hostname %s\n", hostname);
+	fflush (stdout);
+
+	// with DAN_SET_SAMPLE the misses of the simulated sets are scaled up
+	// to the whole LLC's
+
+	unsigned long long int scale = dan_set_sample ? dan_set_sample : 1;
+
+	// printf ("L3 counts: %lld %lld %lld %lld ", LLC[0].counts[0], LLC[0].counts[1], LLC[0].counts[2], LLC[0].counts[6]);
+	printf ("L3 instructions: ");
+	for (i=0; i<ncores; i++) printf ("core %d: %lld ", i, last_insts[i]-insts_at_warming[i]);
+	printf ("\n");
+
+	// with several policies, each line of results is labeled with its policy
+
+	for (int p=0; p<npolicies; p++) {
+		char label[48] = "";
+		if (npolicies > 1) snprintf (label, sizeof (label), "policy %s ", policies[p]->name);
+		unsigned long long int *misses = l3_misses[p], *misses_at_warming = l3_misses_at_warming[p];
+		printf ("%sL3 misses: ", label);
+		for (i=0; i<ncores; i++) printf ("core %d: %lld ", i, (misses[i]-misses_at_warming[i]) * scale);
+		printf ("\n%sL3 mpki: ", label);
+		for (i=0; i<ncores; i++) printf ("core %d: %0.4f ", i, 1000.0 * ((misses[i]-misses_at_warming[i]) * scale) / (double) (last_insts[i]-insts_at_warming[i]));
+		printf ("\n");
+		if (dan_set_sample && !warming) {
+			printf ("%sL3 mpki 95%% CI: ", label);
+			for (i=0; i<ncores; i++) {
+				double lo, hi;
+				set_sample_interval (p, i, &lo, &hi);
+				printf ("core %d: %0.4f to %0.4f ", i, 1000.0 * lo / insts[i], 1000.0 * hi / insts[i]);
+			}
+			printf ("\n");
+		}
+	}
+	for (int p=0; p<npolicies; p++) {
+		char label[48] = "";
+		if (npolicies > 1) snprintf (label, sizeof (label), "policy %s ", policies[p]->name);
+		unsigned long long int *misses = l3_misses[p], *misses_at_warming = l3_misses_at_warming[p];
+		if (!warming) for (i=0; i<ncores; i++) {
+			const char *name = readers[i]->getname ();
+			model *m = NULL;
+			for (int j=0; models[j].name; j++) {
+				if (strstr (name, models[j].name)) {
+					m = &models[j];
+					break;
+				}
+			}
+			if (!m) fprintf (stderr, "no model! defaulting to stupid model.\n");
+			double cpi = model_cpi (m, ((misses[i]-misses_at_warming[i]) * scale) / (double) (last_insts[i]-insts_at_warming[i]));
+			printf ("%score %d: %0.4f IPC\n", label, i, 1 / cpi);
+			if (dan_set_sample) {
+				// fewer misses, more IPC
+				double lo, hi;
+				set_sample_interval (p, i, &lo, &hi);
+				printf ("%sIPC 95%% CI: core %d: %0.4f to %0.4f\n", label, i,
+					1 / model_cpi (m, hi / insts[i]), 1 / model_cpi (m, lo / insts[i]));
+			}
+		}
+	}
+	fflush (stdout);
+}
@@ -0,0 +1,88 @@
+// true LRU, keeping the stack position of every way in a set: 0 for the
+// MRU way, assoc-1 for the LRU one.  the cache and the replacement state
+// share one such record per set, in two layouts:
+//
+// - up to LRU_MAX_ASSOC (16) ways, an lruword per set (the replacement
+//   state's lru) with the positions packed 4 bits apiece: nibble w holds
+//   the position of way w, and nibbles past assoc hold 15, which no
+//   update moves.  the lru_* functions work on these.
+// - beyond that, up to LRU_WIDE_MAX_ASSOC (64), a byte per way, assoc of
+//   them per set side by side (the replacement state's lruWide), which
+//   the lru_wide_* functions work on.
+
+#ifndef __LRU_H
+#define __LRU_H
+
+#define LRU_MAX_ASSOC	16	// the most ways an lruword holds
+
+typedef unsigned long long int lruword;
+
+#define LRU_NIBBLES	0x1111111111111111ULL
+#define LRU_BYTES	0x0101010101010101ULL
+#define LRU_LOW4	0x0f0f0f0f0f0f0f0fULL
+
+// the word for a set whose way w is at stack position w
+
+static inline lruword lru_init (int assoc) {
+	lruword w = 0;
+	for (int i=LRU_MAX_ASSOC-1; i>=0; i--) w = (w << 4) | (i < assoc ? i : 15);
+	return w;
+}
+
+static inline unsigned int lru_position (lruword w, int way) {
+	return (w >> (way * 4)) & 15;
+}
+
+// add one to each byte of x that is below p.  the bytes hold 0..15, so
+// with the top bit of each set first, subtracting p never borrows from
+// the byte above and leaves that bit set exactly where x >= p.
+
+static inline lruword lru_bump (lruword x, int p) {
+	lruword ge = ((x | (LRU_BYTES << 7)) - p * LRU_BYTES) & (LRU_BYTES << 7);
+	return x + ((~ge & (LRU_BYTES << 7)) >> 7);
+}
+
+// make way the MRU one; every way above it in the stack moves down one
+
+static inline lruword lru_touch (lruword w, int way) {
+	int p = lru_position (w, way);
+	lruword even = lru_bump (w & LRU_LOW4, p);
+	lruword odd = lru_bump ((w >> 4) & LRU_LOW4, p);
+	return (even | (odd << 4)) & ~(15ULL << (way * 4));
+}
+
+// the way at stack position p, which must be below assoc.  a nibble of y
+// is zero iff neither its top bit nor, after adding 7, its low three are.
+
+static inline int lru_find (lruword w, int p) {
+	lruword y = w ^ (p * LRU_NIBBLES);
+	lruword zero = ~(((y & (7 * LRU_NIBBLES)) + 7 * LRU_NIBBLES) | y | (7 * LRU_NIBBLES));
+	return __builtin_ctzll (zero) >> 2;
+}
+
+static inline int lru_victim (lruword w, int assoc) {
+	return lru_find (w, assoc - 1);
+}
+
+// the byte per way layout, for more ways than fit in an lruword.  p is a
+// set's assoc bytes.
+
+#define LRU_WIDE_MAX_ASSOC	64
+
+static inline void lru_wide_init (unsigned char *p, int assoc) {
+	for (int i=0; i<assoc; i++) p[i] = i;
+}
+
+static inline void lru_wide_touch (unsigned char *p, int assoc, int way) {
+	unsigned char q = p[way];
+	for (int i=0; i<assoc; i++) p[i] += p[i] < q;
+	p[way] = 0;
+}
+
+static inline int lru_wide_victim (const unsigned char *p, int assoc) {
+	int i;
+	for (i=0; p[i] != assoc - 1; i++);
+	return i;
+}
+
+#endif
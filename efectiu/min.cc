@@ -0,0 +1,194 @@
+// the MIN oracle's next-use annotation; see min.h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "min.h"
+
+#define EMPTY	(~0ull)
+
+minoracle min_oracle;
+
+// the backward pass's table from block address to the index of the latest
+// access to it seen so far, which is the next access after the one being
+// annotated.  open addressing, doubling when half full.
+
+struct nexttable {
+	unsigned long long int *keys;
+	unsigned int *next;
+	unsigned long long int size, used;
+	int	bits;
+};
+
+static void init_nexttable (nexttable *t, int bits) {
+	t->bits = bits;
+	t->size = 1ull << bits;
+	t->used = 0;
+	t->keys = new unsigned long long int[t->size];
+	t->next = new unsigned int[t->size];
+	for (unsigned long long int i=0; i<t->size; i++) t->keys[i] = EMPTY;
+}
+
+static inline unsigned long long int slot (nexttable *t, unsigned long long int key) {
+	unsigned long long int i = (key * 0x9e3779b97f4a7c15ull) >> (64 - t->bits);
+	while (t->keys[i] != key && t->keys[i] != EMPTY) i = (i + 1) & (t->size - 1);
+	return i;
+}
+
+static void grow (nexttable *t) {
+	nexttable old = *t;
+	init_nexttable (t, old.bits + 1);
+	for (unsigned long long int i=0; i<old.size; i++) if (old.keys[i] != EMPTY) {
+		unsigned long long int j = slot (t, old.keys[i]);
+		t->keys[j] = old.keys[i];
+		t->next[j] = old.next[i];
+	}
+	t->used = old.used;
+	delete[] old.keys;
+	delete[] old.next;
+}
+
+// the index of key's next access, or MIN_NEVER, making index its newest
+
+static inline unsigned int exchange (nexttable *t, unsigned long long int key, unsigned int index) {
+	unsigned long long int i = slot (t, key);
+	if (t->keys[i] == EMPTY) {
+		if (2 * (t->used + 1) > t->size) {
+			grow (t);
+			i = slot (t, key);
+		}
+		t->keys[i] = key;
+		t->next[i] = index;
+		t->used++;
+		return MIN_NEVER;
+	}
+	unsigned int next = t->next[i];
+	t->next[i] = index;
+	return next;
+}
+
+static void spill_name (char *buf, size_t n, const char *name) {
+	snprintf (buf, n, "%s.blocks", name);
+}
+
+bool open_min (minoracle *m, const char *name, int offset_bits) {
+	m->name = name;
+	m->offset_bits = offset_bits;
+	int fd = open (name, O_RDONLY);
+	if (fd >= 0) {
+		struct stat st;
+		fstat (fd, &st);
+		m->map_bytes = st.st_size;
+		void *map = mmap (NULL, m->map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+		close (fd);
+		if (map == MAP_FAILED) {
+			perror (name);
+			exit (1);
+		}
+		madvise (map, m->map_bytes, MADV_SEQUENTIAL);
+		const minheader *h = (const minheader *) map;
+		if (m->map_bytes < sizeof (minheader) || memcmp (h->magic, MIN_TRACE_MAGIC, sizeof (h->magic))
+			|| h->version != MIN_TRACE_VERSION || m->map_bytes < sizeof (minheader) + h->n * sizeof (mintrace)) {
+			fprintf (stderr, "%s: bad or unfinished MIN trace; remove it and make it again\n", name);
+			exit (1);
+		}
+		if (h->offset_bits != offset_bits) {
+			fprintf (stderr, "%s: made for %d-byte blocks\n", name, 1 << h->offset_bits);
+			exit (1);
+		}
+		m->header = h;
+		m->records = (const mintrace *) (h + 1);
+		return true;
+	}
+	return false;
+}
+
+void start_min_record (minoracle *m, unsigned long long int first) {
+	char spill[1000];
+	spill_name (spill, sizeof (spill), m->name);
+	m->spill = fopen (spill, "w+");
+	if (!m->spill) {
+		perror (spill);
+		exit (1);
+	}
+	m->chunk = new unsigned long long int[MIN_CHUNK];
+	m->first = first;
+}
+
+void min_record (minoracle *m, unsigned long long int address) {
+	m->chunk[m->n % MIN_CHUNK] = address >> m->offset_bits;
+	m->n++;
+	if (m->n % MIN_CHUNK == 0) {
+		if (fwrite (m->chunk, sizeof (unsigned long long int), MIN_CHUNK, m->spill) != MIN_CHUNK) {
+			perror (m->name);
+			exit (1);
+		}
+	}
+}
+
+// read the chunks back last to first, annotating each from its end, and
+// write each chunk's records where they go in the file.  the header goes
+// last so that a file left unfinished is never taken for a good one.
+
+void finish_min (minoracle *m) {
+	unsigned long long int tail = m->n % MIN_CHUNK, nchunks = (m->n + MIN_CHUNK - 1) / MIN_CHUNK;
+	if (m->first + m->n >= MIN_NEVER) {
+		fprintf (stderr, "%s: %llu accesses are too many for a MIN trace\n", m->name, m->first + m->n);
+		exit (1);
+	}
+	if (tail && fwrite (m->chunk, sizeof (unsigned long long int), tail, m->spill) != tail) {
+		perror (m->name);
+		exit (1);
+	}
+	FILE *f = fopen (m->name, "w");
+	if (!f) {
+		perror (m->name);
+		exit (1);
+	}
+	mintrace *out = new mintrace[MIN_CHUNK];
+	nexttable t;
+	init_nexttable (&t, 20);
+	for (long long int c=nchunks-1; c>=0; c--) {
+		unsigned long long int n = (c == (long long int) nchunks - 1 && tail) ? tail : MIN_CHUNK;
+		unsigned long long int base = m->first + c * MIN_CHUNK;
+		if (fseeko (m->spill, c * MIN_CHUNK * sizeof (unsigned long long int), SEEK_SET)
+			|| fread (m->chunk, sizeof (unsigned long long int), n, m->spill) != n) {
+			perror (m->name);
+			exit (1);
+		}
+		for (long long int i=n-1; i>=0; i--) {
+			out[i].block = (unsigned int) m->chunk[i];
+			out[i].index_of_next_access = exchange (&t, m->chunk[i], base + i);
+		}
+		if (fseeko (f, sizeof (minheader) + c * MIN_CHUNK * sizeof (mintrace), SEEK_SET)
+			|| fwrite (out, sizeof (mintrace), n, f) != n) {
+			perror (m->name);
+			exit (1);
+		}
+	}
+	minheader h;
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, MIN_TRACE_MAGIC, sizeof (h.magic));
+	h.version = MIN_TRACE_VERSION;
+	h.offset_bits = m->offset_bits;
+	h.first = m->first;
+	h.n = m->n;
+	if (fseeko (f, 0, SEEK_SET) || fwrite (&h, sizeof (h), 1, f) != 1 || fclose (f)) {
+		perror (m->name);
+		exit (1);
+	}
+	fclose (m->spill);
+	char spill[1000];
+	spill_name (spill, sizeof (spill), m->name);
+	unlink (spill);
+	fprintf (stderr, "wrote MIN trace %s: %llu accesses to %llu blocks\n", m->name, m->n, t.used);
+	delete[] out;
+	delete[] t.keys;
+	delete[] t.next;
+	delete[] m->chunk;
+}
@@ -0,0 +1,94 @@
+// Belady's MIN, the optimal replacement policy, as an oracle built offline
+
+#ifndef __MIN_H
+#define __MIN_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+// MIN evicts the block that is used again furthest in the future, so it
+// needs the index of each LLC access's next access to the same block.  a
+// run with DAN_MIN_TRACE=file and no such file records the block address
+// of every access, spilling them to file.blocks a chunk at a time; when
+// it ends, one backward pass over the chunks, last to first, with a hash
+// table from block to the index it was last seen at, annotates each access
+// with its next use.  the annotated file is a minheader followed by one
+// mintrace per access, which later runs mmap for the min policies.
+
+#define MIN_TRACE_MAGIC		"efctmin"
+#define MIN_TRACE_VERSION	1
+#define MIN_NEVER		0xffffffffu	// not accessed again
+#define MIN_CHUNK		(1<<22)		// accesses per spilled chunk
+
+struct minheader {
+	char	magic[8];
+	int	version, offset_bits;
+	unsigned long long int first, n;	// the accesses covered: first through first+n-1
+};
+
+struct mintrace {
+	unsigned int block;			// low 32 bits of the block address, to check against
+	unsigned int index_of_next_access;	// or MIN_NEVER
+};
+
+// the main loop records into this, or sets now for the oracle to read
+
+struct minoracle {
+	const char *name;
+
+	// recording: the unspilled tail of the stream and where it goes
+
+	FILE	*spill;
+	unsigned long long int *chunk;
+	unsigned long long int first, n;
+	int	offset_bits;
+
+	// reading: the mapped file, how many policies use it, and the index
+	// of the access being simulated
+
+	const minheader *header;
+	const mintrace *records;
+	size_t	map_bytes;
+	int	users;
+	unsigned long long int now;
+};
+
+extern minoracle min_oracle;
+
+// map the file name if it is there and return true, or return false
+
+bool open_min (minoracle *m, const char *name, int offset_bits);
+
+// record the accesses from index first on, to write to that file
+
+void start_min_record (minoracle *m, unsigned long long int first);
+void min_record (minoracle *m, unsigned long long int address);
+
+// annotate the recorded accesses and write them to the file
+
+void finish_min (minoracle *m);
+
+// the record of the access being simulated
+
+static inline const mintrace *min_now (minoracle *m) {
+	const minheader *h = m->header;
+	unsigned long long int i = m->now - h->first;
+	if (m->now < h->first || i >= h->n) {
+		fprintf (stderr, "%s: access %llu is past the accesses it has; make it again with a longer run\n", m->name, m->now);
+		exit (1);
+	}
+	return &m->records[i];
+}
+
+// the same, checking that the access is to address
+
+static inline const mintrace *min_current (minoracle *m, unsigned long long int address) {
+	const mintrace *r = min_now (m);
+	if (r->block != (unsigned int) (address >> m->header->offset_bits)) {
+		fprintf (stderr, "%s: access %llu is to a different block; it was made from other traces or options\n", m->name, m->now);
+		exit (1);
+	}
+	return r;
+}
+
+#endif
@@ -0,0 +1,138 @@
+// sampled miss ratio curves; see mrc.h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <assert.h>
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "mrc.h"
+
+int lg2 (int n);
+
+#define COUNT(m,a,c,core,g)	((a)[((c) * (m)->ncores + (core)) * MRC_GROUPS + (g)])
+
+void init_mrc (mrc *m, int sample, const policy_info **policies, int npolicies, int nsets, int assoc, int blocksize, int set_shift, int ncores) {
+	m->sample_bits = lg2 (sample);
+	m->npolicies = npolicies;
+	m->ncores = ncores;
+	m->offset_bits = lg2 (blocksize);
+	m->llc_bytes = (unsigned long long int) nsets * assoc * blocksize;
+
+	// the capacities that leave a miniature cache from two sets up to MAX_SETS
+
+	m->ncaches = 0;
+	for (int s=MRC_MIN_SCALE; s<=MRC_MAX_SCALE; s++) {
+		long long int sets = s < 0 ? (nsets >> -s) >> m->sample_bits : ((long long int) nsets << s) >> m->sample_bits;
+		if (sets >= 2 && sets <= MAX_SETS) m->scale[m->ncaches++] = s;
+	}
+	m->names = new const char *[npolicies];
+	m->caches = new cache[npolicies * m->ncaches];
+	CACHE_REPLACEMENT_STATE::miniature = sample;
+	for (int p=0; p<npolicies; p++) {
+		m->names[p] = policies[p]->name;
+		for (int k=0; k<m->ncaches; k++) {
+			int s = m->scale[k];
+			int sets = (s < 0 ? nsets >> -s : nsets << s) >> m->sample_bits;
+			init_cache (&m->caches[p*m->ncaches+k], sets, assoc, blocksize, policies[p], set_shift);
+		}
+	}
+	CACHE_REPLACEMENT_STATE::miniature = 1;
+	int n = npolicies * m->ncaches * ncores * MRC_GROUPS;
+	m->accesses = new unsigned long long int[n];
+	m->misses = new unsigned long long int[n];
+	m->accesses_at_warming = new unsigned long long int[n];
+	m->misses_at_warming = new unsigned long long int[n];
+	memset (m->accesses, 0, n * sizeof (unsigned long long int));
+	memset (m->misses, 0, n * sizeof (unsigned long long int));
+	memset (m->accesses_at_warming, 0, n * sizeof (unsigned long long int));
+	memset (m->misses_at_warming, 0, n * sizeof (unsigned long long int));
+}
+
+// splitmix64's finalizer, so that every bit of the block address moves
+// the sampling and grouping bits
+
+static inline unsigned long long int mix (unsigned long long int x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+	return x ^ (x >> 31);
+}
+
+// the low sample_bits of the hash pick the sampled blocks and the top bits
+// their group.  like cache_access, count every access but only count the
+// misses of those that aren't writebacks or prefetches.
+
+void mrc_access (mrc *m, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core) {
+	unsigned long long int h = mix (address >> m->offset_bits);
+	if (h & ((1ull << m->sample_bits) - 1)) return;
+	int g = h >> 61;
+	bool counted = op != DAN_WRITEBACK && op != DAN_PREFETCH;
+	for (int c=0; c<m->npolicies*m->ncaches; c++) {
+		unsigned int miss = memory_access (NULL, NULL, &m->caches[c], address, pc, size, op, core);
+		if (counted) COUNT (m, m->accesses, c, core, g)++;
+		if (miss & 4) COUNT (m, m->misses, c, core, g)++;
+	}
+}
+
+void mrc_warmed (mrc *m) {
+	int n = m->npolicies * m->ncaches * m->ncores * MRC_GROUPS;
+	memcpy (m->accesses_at_warming, m->accesses, n * sizeof (unsigned long long int));
+	memcpy (m->misses_at_warming, m->misses, n * sizeof (unsigned long long int));
+}
+
+void checkpoint_mrc (FILE *f, mrc *m, bool restore) {
+	for (int c=0; c<m->npolicies*m->ncaches; c++) checkpoint_cache (f, &m->caches[c], restore);
+	int n = m->npolicies * m->ncaches * m->ncores * MRC_GROUPS;
+	CheckpointIO (f, restore, m->accesses, n * sizeof (unsigned long long int));
+	CheckpointIO (f, restore, m->misses, n * sizeof (unsigned long long int));
+	CheckpointIO (f, restore, m->accesses_at_warming, n * sizeof (unsigned long long int));
+	CheckpointIO (f, restore, m->misses_at_warming, n * sizeof (unsigned long long int));
+}
+
+// the mean of v[0..n-1] and its standard error
+
+static void estimate (double *v, int n, double *mean, double *err) {
+	double sum = 0, sq = 0;
+	for (int i=0; i<n; i++) sum += v[i];
+	*mean = n ? sum / n : 0;
+	for (int i=0; i<n; i++) sq += (v[i] - *mean) * (v[i] - *mean);
+	*err = n > 1 ? sqrt (sq / (n - 1) / n) : 0;
+}
+
+// print a table for each policy and core: one row per capacity, with the
+// estimated MPKI and miss ratio and the standard error of each, which is
+// the spread of sampling alone and not the miniature caches' bias.  a
+// group is 1/MRC_GROUPS of the sample, so its estimates are scaled up by
+// that much more.
+
+void print_mrc (mrc *m, unsigned long long int *insts) {
+	for (int p=0; p<m->npolicies; p++) for (int core=0; core<m->ncores; core++) {
+		printf ("%s miss ratio curve from 1 in %d blocks for core %d:\n", m->names[p], 1 << m->sample_bits, core);
+		printf ("%10s %8s %9s %9s %10s %9s\n", "capacity", "sets", "mpki", "+-sample", "miss ratio", "+-sample");
+		for (int k=0; k<m->ncaches; k++) {
+			int c = p * m->ncaches + k;
+			double mpki[MRC_GROUPS], ratio[MRC_GROUPS];
+			unsigned long long int misses = 0, accesses = 0;
+			int nratio = 0;
+			for (int g=0; g<MRC_GROUPS; g++) {
+				unsigned long long int mg = COUNT (m, m->misses, c, core, g) - COUNT (m, m->misses_at_warming, c, core, g);
+				unsigned long long int ag = COUNT (m, m->accesses, c, core, g) - COUNT (m, m->accesses_at_warming, c, core, g);
+				misses += mg;
+				accesses += ag;
+				mpki[g] = 1000.0 * mg * MRC_GROUPS * (1 << m->sample_bits) / (double) insts[core];
+				if (ag) ratio[nratio++] = mg / (double) ag;
+			}
+			double mean, mpki_err, ratio_err;
+			estimate (mpki, MRC_GROUPS, &mean, &mpki_err);
+			estimate (ratio, nratio, &mean, &ratio_err);
+			int s = m->scale[k];
+			unsigned long long int bytes = s < 0 ? m->llc_bytes >> -s : m->llc_bytes << s;
+			printf ("%8lluKB %8d %9.3f %9.3f %10.4f %9.4f\n", bytes >> 10, m->caches[c].nsets,
+				1000.0 * misses * (1 << m->sample_bits) / (double) insts[core], mpki_err,
+				accesses ? misses / (double) accesses : 0, ratio_err);
+		}
+	}
+	fflush (stdout);
+}
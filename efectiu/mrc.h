@@ -0,0 +1,39 @@
+// sampled miss ratio curves from miniature caches
+
+#ifndef __MRC_H
+#define __MRC_H
+
+// SHARDS-style spatial sampling: a block is sampled when a hash of its
+// address falls in 1/sample of the hash's range, so a sampled block has
+// all of its accesses sampled.  a cache with 1/sample of the sets of an
+// LLC then sees about what each of the LLC's sets does, and its miss ratio
+// estimates the LLC's.  every policy gets a miniature cache for each
+// power of two from 1/16 to 16 times the LLC's capacity that leaves it at
+// least two sets, all fed the same sampled accesses.
+//
+// the sampled blocks fall into MRC_GROUPS groups by another part of the
+// hash, and the spread of the groups' own estimates gives the error.
+
+#define MRC_MIN_SCALE	-4	// capacities from 2^-4 ...
+#define MRC_MAX_SCALE	4	// ... to 2^4 times the LLC's
+#define MRC_GROUPS	8
+
+struct mrc {
+	int	sample_bits, npolicies, ncaches, ncores, offset_bits;
+	int	scale[MRC_MAX_SCALE-MRC_MIN_SCALE+1];	// each cache's capacity is the LLC's times 2^scale
+	unsigned long long int llc_bytes;
+	const char **names;			// the policies
+	cache	*caches;			// caches[p*ncaches+k]
+
+	// counts[((p*ncaches+k)*ncores+core)*MRC_GROUPS+g]
+
+	unsigned long long int *accesses, *misses, *accesses_at_warming, *misses_at_warming;
+};
+
+void init_mrc (mrc *m, int sample, const policy_info **policies, int npolicies, int nsets, int assoc, int blocksize, int set_shift, int ncores);
+void mrc_access (mrc *m, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core);
+void mrc_warmed (mrc *m);
+void checkpoint_mrc (FILE *f, mrc *m, bool restore);
+void print_mrc (mrc *m, unsigned long long int *insts);
+
+#endif
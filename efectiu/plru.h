@@ -0,0 +1,34 @@
+// tree pseudo-LRU for a power of two ways, up to 64, with the assoc-1
+// nodes of a set's tree packed into one word.  the tree is a heap: node n
+// has children 2n+1 and 2n+2, and way w is leaf assoc-1+w.  bit n is 0 when
+// the next victim is under node n's left child, 1 when under its right.
+// a set starts at 0, replacing way 0 first.
+
+#ifndef __PLRU_H
+#define __PLRU_H
+
+typedef unsigned long long int plruword;
+
+// follow the bits from the root down to a leaf
+
+static inline int plru_victim (plruword w, int assoc) {
+	int n = 0;
+	for (int l=__builtin_ctz (assoc); l; l--) n = 2 * n + 1 + ((w >> n) & 1);
+	return n - (assoc - 1);
+}
+
+// point every node on the path to way away from it.  at depth d of a tree
+// of depth l the path is at node 2^d-1 + (way >> (l-d)), and goes right
+// from there when bit l-1-d of way is set.
+
+static inline plruword plru_touch (plruword w, int assoc, int way) {
+	int l = __builtin_ctz (assoc);
+	for (int d=0; d<l; d++) {
+		int n = (1 << d) - 1 + (way >> (l - d));
+		plruword left = ~(way >> (l - 1 - d)) & 1;
+		w = (w & ~(1ULL << n)) | (left << n);
+	}
+	return w;
+}
+
+#endif
@@ -0,0 +1,38 @@
+// the registry of replacement policies; see policy.h
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "policy.h"
+
+static policy_info *policies;
+
+register_policy::register_policy (policy_info *p) {
+	policy_info **q;
+	for (q=&policies; *q && strcmp ((*q)->name, p->name) < 0; q=&(*q)->next);
+	assert (!*q || strcmp ((*q)->name, p->name));
+	p->next = *q;
+	*q = p;
+}
+
+const policy_info *find_policy (const char *name) {
+	for (policy_info *p=policies; p; p=p->next)
+		if (!strcmp (p->name, name)) return p;
+	return NULL;
+}
+
+cache_access_fn find_accessor (const policy_info *p, int nsets, int assoc, int blocksize) {
+	bool pow2sets = !(nsets & (nsets - 1));
+	for (int k=0; k<MAX_ACCESSORS; k++) {
+		const cache_accessor *a = &p->accessors[k];
+		if ((!a->assoc || a->assoc == assoc) && (!a->blocksize || a->blocksize == blocksize) && (!a->pow2sets || pow2sets))
+			return a->access;
+	}
+	assert (0);
+	return NULL;
+}
+
+void list_policies (FILE *f) {
+	for (policy_info *p=policies; p; p=p->next)
+		fprintf (f, "\t%-12s%s\n", p->name, p->description);
+}
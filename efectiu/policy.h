@@ -0,0 +1,73 @@
+// the replacement policies the simulator knows, by name.  each policy lives
+// in its own policy_*.cpp as a subclass of CACHE_REPLACEMENT_STATE and
+// registers itself there with REGISTER_POLICY; DAN_POLICY picks one by
+// name through find_policy ().
+
+#ifndef __POLICY_H
+#define __POLICY_H
+
+#include <stdio.h>
+#include "utils.h"
+
+class CACHE_REPLACEMENT_STATE;
+struct cache;
+
+typedef bool (*cache_access_fn) (struct cache *c, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core, unsigned long long int *writeback_address);
+
+// cache_access_t () specialized for a policy and a geometry; a geometry of 0
+// matches any cache, and pow2sets only matches a power of two sets.  every
+// policy gets fast paths for 8, 16 and 32 ways of 64-byte blocks in a power
+// of two sets, the common LLC configurations, and a slower one for the rest.
+
+struct cache_accessor {
+	int	assoc, blocksize;
+	bool	pow2sets;
+	cache_access_fn access;
+};
+
+#define MAX_ACCESSORS	4
+
+struct policy_info {
+	const char *name, *description;
+	CACHE_REPLACEMENT_STATE *(*make) (UINT32 sets, UINT32 assoc);
+	cache_accessor accessors[MAX_ACCESSORS];
+	bool	pow2assoc;			// only works with a power of two ways
+	policy_info *next;
+};
+
+// adds a policy to the registry, which is kept sorted by name
+
+struct register_policy {
+	register_policy (policy_info *p);
+};
+
+// register a policy.  make is a function returning a new replacement state
+// for a cache of the given sets and ways, and hooks a type with the victim ()
+// and update () hooks of cache_access_t (); see cache_access.h.
+// REGISTER_POW2_POLICY registers one that needs a power of two ways.
+
+#define REGISTER_POLICY(name, make, hooks, description) \
+	REGISTER_POLICY_WAYS (name, make, hooks, description, false)
+#define REGISTER_POW2_POLICY(name, make, hooks, description) \
+	REGISTER_POLICY_WAYS (name, make, hooks, description, true)
+#define REGISTER_POLICY_WAYS(name, make, hooks, description, pow2assoc) \
+	static policy_info policy_info_##make = { name, description, make, { \
+		{ 16, 64, true, cache_access_t<hooks, 16, 64, true> }, \
+		{ 8, 64, true, cache_access_t<hooks, 8, 64, true> }, \
+		{ 32, 64, true, cache_access_t<hooks, 32, 64, true> }, \
+		{ 0, 0, false, cache_access_t<hooks, 0, 0, false> } }, pow2assoc, NULL }; \
+	static register_policy register_##make (&policy_info_##make);
+
+// the policy called name, or NULL
+
+const policy_info *find_policy (const char *name);
+
+// the access function of p for a cache of the given geometry
+
+cache_access_fn find_accessor (const policy_info *p, int nsets, int assoc, int blocksize);
+
+// print the name and description of every policy, one per line
+
+void list_policies (FILE *f);
+
+#endif
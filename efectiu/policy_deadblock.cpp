@@ -0,0 +1,177 @@
+#include "cache_access.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Sampling Dead Block Prediction (S. Khan, Y. Tian, D.A. Jimenez).  A small  //
+// sampler of partial tags, with its own LRU, follows a few of the sets and   //
+// trains tables of counters indexed by the PC that last touched a block:     //
+// up when a sampled block is evicted untouched, down when it is hit again.   //
+// A block whose last PC the tables call dead is replaced first, and a fill   //
+// predicted dead bypasses the cache.  Otherwise the set is LRU.              //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+#define DBP_SAMPLER_SETS	32
+#define DBP_SAMPLER_ASSOC	12
+#define DBP_TABLES		3
+#define DBP_TABLE_SIZE		4096
+#define DBP_COUNTER_MAX		3	// 2-bit counters
+#define DBP_THRESHOLD		8	// dead if the counters sum to at least this
+#define DBP_PARTIAL_BITS	15
+
+struct DBPSamplerSet {
+	UINT32 partialTag[DBP_SAMPLER_ASSOC];
+	UINT32 partialPC[DBP_SAMPLER_ASSOC];	// last PC to touch the block
+	bool valid[DBP_SAMPLER_ASSOC];
+	lruword lru;
+};
+
+class DEADBLOCK_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    bool *dead;		// dead[set*assoc+way], the prediction for the block's last access
+
+    UINT32 samplerSize;
+    DBPSamplerSet *sampler;
+
+    UINT32 *predictorTable[DBP_TABLES];
+
+  public:
+    DEADBLOCK_POLICY( UINT32 _sets, UINT32 _assoc );
+
+    UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+    void   Checkpoint(FILE *f, bool restore);
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType );
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit );
+
+  private:
+    UINT32 PartialPC( Addr_t PC ) { return PC & ((1<<DBP_PARTIAL_BITS)-1); }
+    UINT32 TableIndex( UINT32 table, UINT32 partialPC );
+    bool   PredictDead( UINT32 partialPC );
+    void   Train( UINT32 partialPC, bool dead );
+    void   UpdateSampler( UINT32 samplerSetIndex, Addr_t tag, UINT32 partialPC );
+};
+
+DEADBLOCK_POLICY::DEADBLOCK_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    dead = Carve<bool>( numsets * assoc );
+
+    samplerSize = numsets < DBP_SAMPLER_SETS ? numsets : DBP_SAMPLER_SETS;
+    AssignSetRoles( samplerSize, 1, SETS_STRIDED );
+    sampler = Carve<DBPSamplerSet>( samplerSize );
+    for(UINT32 s=0; s<samplerSize; s++)
+	sampler[s].lru = lru_init( DBP_SAMPLER_ASSOC );
+
+    for(UINT32 t=0; t<DBP_TABLES; t++)
+	predictorTable[t] = Carve<UINT32>( DBP_TABLE_SIZE );
+}
+
+UINT32 DEADBLOCK_POLICY::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    for(UINT32 t=0; t<DBP_TABLES; t++){
+	g[t].s = NULL;
+	g[t].u = predictorTable[t];
+	g[t].s8 = NULL;
+	g[t].n = DBP_TABLE_SIZE;
+	g[t].lo = 0;
+	g[t].hi = DBP_COUNTER_MAX;
+    }
+    return DBP_TABLES;
+}
+
+void DEADBLOCK_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, dead, numsets * assoc * sizeof(bool));
+    CheckpointIO(f, restore, sampler, samplerSize * sizeof(DBPSamplerSet));
+    for(UINT32 t=0; t<DBP_TABLES; t++)
+	CheckpointIO(f, restore, predictorTable[t], DBP_TABLE_SIZE * sizeof(UINT32));
+}
+
+// each table hashes the partial PC differently, so PCs that collide in one
+// table rarely collide in the others
+
+UINT32 DEADBLOCK_POLICY::TableIndex( UINT32 table, UINT32 partialPC )
+{
+    UINT32 h = (partialPC + table) * 0x9e3779b1u;
+    return (h >> (7 + 4 * table)) & (DBP_TABLE_SIZE - 1);
+}
+
+bool DEADBLOCK_POLICY::PredictDead( UINT32 partialPC )
+{
+    UINT32 sum = 0;
+    for(UINT32 t=0; t<DBP_TABLES; t++)
+	sum += predictorTable[t][ TableIndex( t, partialPC ) ];
+    return sum >= DBP_THRESHOLD;
+}
+
+void DEADBLOCK_POLICY::Train( UINT32 partialPC, bool isDead )
+{
+    for(UINT32 t=0; t<DBP_TABLES; t++){
+	UINT32 *c = &predictorTable[t][ TableIndex( t, partialPC ) ];
+	if(isDead){
+	    if(*c < DBP_COUNTER_MAX) (*c)++;
+	}else{
+	    if(*c > 0) (*c)--;
+	}
+    }
+}
+
+// an access to a sampled set: a hit in the sampler means the block's last PC
+// did not leave it dead, and the sampler's LRU victim was evicted dead
+
+void DEADBLOCK_POLICY::UpdateSampler( UINT32 samplerSetIndex, Addr_t tag, UINT32 partialPC )
+{
+    DBPSamplerSet *s = &sampler[ samplerSetIndex ];
+    UINT32 partialTag = tag & ((1<<DBP_PARTIAL_BITS)-1);
+    INT32 way = -1;
+    for(UINT32 w=0; w<DBP_SAMPLER_ASSOC; w++){
+	if(s->valid[w] && s->partialTag[w] == partialTag){
+	    way = w;
+	    break;
+	}
+    }
+    if(way >= 0){
+	Train( s->partialPC[way], false );
+    }else{
+	way = lru_victim( s->lru, DBP_SAMPLER_ASSOC );
+	if(s->valid[way]) Train( s->partialPC[way], true );
+	s->valid[way] = true;
+	s->partialTag[way] = partialTag;
+    }
+    s->partialPC[way] = partialPC;
+    s->lru = lru_touch( s->lru, way );
+}
+
+INT32 DEADBLOCK_POLICY::GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType ) {
+	// bypass fills predicted dead, except in sampled sets where the sampler
+	// has to see them, and except writebacks, which must be kept
+	if( accessType != ACCESS_WRITEBACK && SetRole( setIndex ) == SET_FOLLOWER && PredictDead( PartialPC( PC ) ) )
+		return -1;
+
+	// replace the first block predicted dead, else the LRU one
+	bool *d = &dead[ setIndex * assoc ];
+	for(UINT32 way=0; way<assoc; way++)
+		if(d[way]) return way;
+	return Get_LRU_Victim( setIndex );
+}
+
+void DEADBLOCK_POLICY::UpdateReplacementState(
+    UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+    UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+{
+	UINT32 partialPC = PartialPC( PC );
+	if( SetRole( setIndex ) != SET_FOLLOWER )
+		UpdateSampler( SetSlot( setIndex ), currLine->tag, partialPC );
+	dead[ setIndex * assoc + updateWayID ] = PredictDead( partialPC );
+	UpdateLRU( setIndex, updateWayID );
+}
+
+static CACHE_REPLACEMENT_STATE *make_deadblock (UINT32 sets, UINT32 assoc) {
+	return new DEADBLOCK_POLICY (sets, assoc);
+}
+
+REGISTER_POLICY ("deadblock", make_deadblock, repl_hooks<DEADBLOCK_POLICY>, "sampling dead block prediction with bypass, over LRU")
@@ -0,0 +1,183 @@
+#include "cache_access.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Dynamic Insertion Policy ( K.Qureshi et. al.) with Set Dueling.  A set can //
+// be assigned LRU policy, BIP (Bimodal Insertion Policy) or it can be just a //
+// follower set.  Without dueling every set is a BIP set, which is plain BIP. //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+// the roles of the sets, from AssignSetRoles
+typedef enum
+{
+  DIP_SD_LRU = SET_ROLE_A, // if set follows LRU policy
+  DIP_SD_BIP = SET_ROLE_B, // if set follows BIP policy
+  DIP_SD_FOLLOWER = SET_FOLLOWER // if set is just a follower set
+}SetDedicationType;
+
+class DIP_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    bool duel;  // false for BIP in every set
+
+    // No. of Sets dedicated to each policy in Set Dueling
+    UINT32 K;
+
+    /*Follower Set Eviction Policy Selector: if MSB(PSEL) is 1, then BIP, otherwise LRU
+      If Miss incurred in LRU dedicated sets, increment PSEL.
+      If Miss incurred in BIP dedicated sets, decrement PSEL.
+    */
+    UINT32 PSEL;
+    UINT32 PSEL_bits; // no of bits for PSEL counter
+
+   /*
+     Inverse of Bimodal Throttle Parameter for BIP
+     Determines the frequency with which a block is inserted in MRU position
+   */
+    UINT32 BIP_frequency;
+
+    UINT32 misses; // counts no of misses in BIP dedicated sets
+
+  public:
+    DIP_POLICY( UINT32 _sets, UINT32 _assoc, bool _duel );
+
+    UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+    void   Checkpoint(FILE *f, bool restore);
+
+    // No matter what set, get the LRU victim
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+    {
+        return Get_LRU_Victim( setIndex );
+    }
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit );
+
+  private:
+    void   UpdateBIP( UINT32 setIndex, INT32 updateWayID, bool cacheHit );
+};
+
+DIP_POLICY::DIP_POLICY( UINT32 _sets, UINT32 _assoc, bool _duel ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    duel = _duel;
+
+    K = 64; // No. Of sets dedicated to each policy
+    // dedicate K sets to each policy by complement-select
+    if(duel) AssignSetRoles(K, 2, SETS_COMPLEMENT);
+
+    // Initialize policy selector to 0
+    PSEL = 0;
+
+    // Inverse Bimodal throttle parameter
+    // That is every BIP_frequency'th miss in BIP sets is placed in MRU position
+    BIP_frequency = 32;
+
+    // Initialize BIP miss counter
+    misses = 0;
+
+    // Set PSEL bits
+    PSEL_bits = 10;
+}
+
+UINT32 DIP_POLICY::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    if (!duel) return 0;
+    g[0].s = NULL;
+    g[0].u = &PSEL;
+    g[0].s8 = NULL;
+    g[0].n = 1;
+    g[0].lo = 0;
+    g[0].hi = (1<<PSEL_bits)-1;
+    return 1;
+}
+
+void DIP_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, &PSEL, sizeof(PSEL));
+    CheckpointIO(f, restore, &misses, sizeof(misses));
+}
+
+// BIP: only every BIP_frequency'th miss is inserted at MRU, the rest stay
+// at LRU, and a hit only promotes a block that is at LRU
+
+void DIP_POLICY::UpdateBIP( UINT32 setIndex, INT32 updateWayID, bool cacheHit ) {
+	if(!cacheHit){
+
+		// Update the block metadata to be at MRU position at frequency of BIP_frequency misses - LRU policy
+		if( misses == BIP_frequency){
+			misses = 0; // reset the misses
+			UpdateLRU(setIndex, updateWayID);
+
+		}
+		// else use LIP. avoiding the receny update here.
+	}
+	// if the access is a hit on an LRU block, then update LRU for the set
+	else {
+		if( LRUPosition( setIndex, updateWayID ) == (assoc - 1) ){
+			UpdateLRU(setIndex, updateWayID);
+		}
+	}
+}
+
+void DIP_POLICY::UpdateReplacementState(
+    UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+    UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+{
+	if(!cacheHit){
+		misses++;
+		if(misses > BIP_frequency){
+		  misses = 0;
+		}
+	}
+	// without dueling every set is BIP
+	if(!duel){
+		UpdateBIP(setIndex, updateWayID, cacheHit);
+		return;
+	}
+	UINT32 dedication = SetRole(setIndex);
+	//update LRU policy for the set if the set is dedicated to LRU
+	if(dedication == DIP_SD_LRU){
+		UpdateLRU(setIndex, updateWayID);
+		// Increment PSEL on a miss in LRU dedicated set, by as many
+		// leader sets as this one stands for
+		if(!cacheHit){
+			PSEL = PSEL + roleWeight < (UINT32)((1<<PSEL_bits)-1) ? PSEL + roleWeight : (1<<PSEL_bits)-1;
+		}
+	}
+	// update BIP policy for the set if the set is dedicated to BIP
+	else if(dedication == DIP_SD_BIP ){
+		// Decrement PSEL on a miss in BIP dedicated set
+		if(!cacheHit){
+			PSEL = PSEL > roleWeight ? PSEL - roleWeight : 0;
+		}
+		UpdateBIP(setIndex, updateWayID, cacheHit);
+	}
+
+	// update Follower set metadata
+	else if(dedication == DIP_SD_FOLLOWER){
+
+		// select the policy depending on the MSB of PSEL
+		if( (((PSEL >> (PSEL_bits - 1))&1) == 1)){
+		  	// MSB is 1, use BIP policy
+			UpdateBIP(setIndex, updateWayID, cacheHit);
+		}else{
+		  // MSB is 0, use LRU policy
+
+		   UpdateLRU(setIndex, updateWayID);
+
+		}
+	}
+}
+
+static CACHE_REPLACEMENT_STATE *make_dip (UINT32 sets, UINT32 assoc) {
+	return new DIP_POLICY (sets, assoc, true);
+}
+
+static CACHE_REPLACEMENT_STATE *make_bip (UINT32 sets, UINT32 assoc) {
+	return new DIP_POLICY (sets, assoc, false);
+}
+
+REGISTER_POLICY ("bip", make_bip, repl_hooks<DIP_POLICY>, "bimodal insertion: LRU, inserting only 1 in 32 misses at MRU")
+REGISTER_POLICY ("dip", make_dip, repl_hooks<DIP_POLICY>, "dynamic insertion: set dueling between LRU and BIP")
@@ -0,0 +1,87 @@
+// LRU and random, the baselines that CRC came with as policies 0 and 1.
+// the cache simulates both itself (see lru_hooks and random_hooks in
+// cache_access.h); these replacement states only back them up for anyone
+// calling the methods directly.  tree pseudo-LRU is here too, as the
+// cheap approximation of LRU that hardware uses.
+
+#include <assert.h>
+#include "cache_access.h"
+#include "plru.h"
+
+class LRU_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  public:
+    LRU_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc ) { }
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+    {
+        return Get_LRU_Victim( setIndex );
+    }
+
+    void  UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                  UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+    {
+        UpdateLRU( setIndex, updateWayID );
+    }
+};
+
+class RANDOM_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  public:
+    RANDOM_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc ) { }
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+    {
+        return Get_Random_Victim( setIndex );
+    }
+
+    // Random replacement requires no replacement state update
+    void  UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                  UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit ) { }
+};
+
+class PLRU_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    plruword *plru; // a word per set; see plru.h
+
+  public:
+    PLRU_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+    {
+        assert( !(assoc & (assoc - 1)) );
+        plru = Carve<plruword>( numsets );
+    }
+
+    void  Checkpoint(FILE *f, bool restore)
+    {
+        CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+        CheckpointIO(f, restore, plru, numsets * sizeof(plruword));
+    }
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+    {
+        return plru_victim( plru[setIndex], assoc );
+    }
+
+    void  UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                  UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+    {
+        plru[setIndex] = plru_touch( plru[setIndex], assoc, updateWayID );
+    }
+};
+
+static CACHE_REPLACEMENT_STATE *make_lru (UINT32 sets, UINT32 assoc) {
+	return new LRU_POLICY (sets, assoc);
+}
+
+static CACHE_REPLACEMENT_STATE *make_random (UINT32 sets, UINT32 assoc) {
+	return new RANDOM_POLICY (sets, assoc);
+}
+
+static CACHE_REPLACEMENT_STATE *make_plru (UINT32 sets, UINT32 assoc) {
+	return new PLRU_POLICY (sets, assoc);
+}
+
+REGISTER_POLICY ("lru", make_lru, lru_hooks, "least recently used")
+REGISTER_POLICY ("random", make_random, random_hooks, "a victim from a counter, like a random one")
+REGISTER_POW2_POLICY ("plru", make_plru, repl_hooks<PLRU_POLICY>, "tree pseudo-LRU, a set's tree in one word")
@@ -0,0 +1,87 @@
+#include "cache_access.h"
+#include "min.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Belady's MIN: replace the block whose next use is furthest in the future, //
+// which gives the fewest misses any replacement policy can.  It reads when   //
+// each access's block is used next from the annotated stream DAN_MIN_TRACE   //
+// names (see min.h).  The bypassing variant also leaves a missing block out  //
+// of the cache when it is used again later than every block in its set.      //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+class MIN_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    bool bypass;
+    UINT32 *nextUse; // nextUse[set*assoc+way]: the index of the block's next access
+
+  public:
+    MIN_POLICY( UINT32 _sets, UINT32 _assoc, bool _bypass );
+
+    void   Checkpoint(FILE *f, bool restore);
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType );
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit );
+};
+
+MIN_POLICY::MIN_POLICY( UINT32 _sets, UINT32 _assoc, bool _bypass ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    bypass = _bypass;
+    nextUse = Carve<UINT32>( numsets * assoc );
+    min_oracle.users++;
+}
+
+void MIN_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, nextUse, numsets * assoc * sizeof(UINT32));
+}
+
+INT32 MIN_POLICY::GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+{
+	const UINT32 *n = &nextUse[setIndex * assoc];
+	INT32 victim = 0;
+	for (UINT32 i=1; i<assoc; i++)
+		if (n[i] > n[victim]) victim = i;
+
+	// a block used no sooner than all of the set's isn't worth a way
+	if (bypass && min_current(&min_oracle, paddr)->index_of_next_access >= n[victim])
+		return -1;
+	return victim;
+}
+
+void MIN_POLICY::UpdateReplacementState(
+    UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+    UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+{
+	nextUse[setIndex * assoc + updateWayID] = min_now(&min_oracle)->index_of_next_access;
+}
+
+// like repl_hooks<MIN_POLICY>, but told about hits by writebacks too: they
+// are accesses like any other, and the block's next use moves past them.
+// every access to the cache checks the stream's address against its own.
+
+struct min_hooks {
+	static inline int victim (cache *c, int assoc, const cache_op *o) {
+		return ((MIN_POLICY *) c->repl)->MIN_POLICY::GetVictimInSet (o->core, o->set, NULL, assoc, o->pc, o->address, o->at);
+	}
+	static inline void update (cache *c, int assoc, int way, bool hit, const cache_op *o) {
+		min_current (&min_oracle, o->address);
+		((MIN_POLICY *) c->repl)->MIN_POLICY::UpdateReplacementState (o->set, way, NULL, o->core, o->pc, o->at, hit);
+	}
+};
+
+static CACHE_REPLACEMENT_STATE *make_min (UINT32 sets, UINT32 assoc) {
+	return new MIN_POLICY (sets, assoc, false);
+}
+
+static CACHE_REPLACEMENT_STATE *make_minbypass (UINT32 sets, UINT32 assoc) {
+	return new MIN_POLICY (sets, assoc, true);
+}
+
+REGISTER_POLICY ("min", make_min, min_hooks, "Belady's MIN from DAN_MIN_TRACE: the block used again furthest ahead")
+REGISTER_POLICY ("minbypass", make_minbypass, min_hooks, "MIN, also bypassing blocks used again later than any in the set")
@@ -0,0 +1,521 @@
+#include "cache_access.h"
+#include "plru.h"
+
+/*
+ Implementing "Perceptron Learning for Reuse Prediction" Paper (E. Teran, Z. Wang, D.A Jimenez)
+*/
+
+// Replacement State Per Cache Line
+typedef struct
+{
+    // Re use prediction bit per block
+    // false if predicted dead, true if reuse
+    bool reusePredictionBit;
+
+} PERCEPTRON_LINE_STATE;
+
+#define PERCEPTRON_FEATURES	6
+#define PERCEPTRON_TABLE_SIZE	256
+
+// one table of weights, indexed by a hashed feature
+typedef INT8 PerceptronTable[PERCEPTRON_TABLE_SIZE];
+
+// A set's pseudo LRU tree and its assoc lines, rounded up to a multiple of 32
+// bytes: 32 for 16 ways, so that a set never straddles a cache line
+
+struct PerceptronSet {
+	// the tree's assoc-1 bits; see plru.h
+	plruword pseudoLRU;
+	PERCEPTRON_LINE_STATE line[];
+} __attribute__ ((aligned (32)));
+
+// Structure for each sampler entry, 12 bytes
+struct PerceptronSamplerEntry {
+
+	// Partial Tag -  Lower 15 bits of tag
+	UINT16 partialTag;
+	// Perceptron output for the sampled line
+	INT16  Yout;
+	// LRU data
+	UINT8  LRUstackposition;
+	// valid bit
+	bool valid;
+	// Sequence of Hashed Features
+	UINT8  features[PERCEPTRON_FEATURES];
+
+};
+
+class PERCEPTRON_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    char   *sets;
+    UINT32 setBytes; // each set's PerceptronSet
+
+    Addr_t recentPCs[4]; // 4 recent program counters. index 0 has current, 1 has previous PC and so on.
+    UINT32 samplerSetNum; // Number of sampler sets
+    UINT32 samplerSetAssoc; // associativity of sampler sets
+    UINT32 featureNum; // Number of features for perceptron learning
+    PerceptronSamplerEntry* sampler; // sampler entries, a set's side by side
+
+    PerceptronTable* predictorTable; // predictor Tables, one after the other
+    UINT32  predictorTableEntryNum; // number of entries in each predictor table
+
+    // the features of the access in progress, so that the bypass prediction
+    // and the update for the same access hash them only once
+    UINT8  currFeatures[PERCEPTRON_FEATURES];
+    bool   currFeaturesValid;
+    UINT32 currFeaturesTag;
+
+    INT32 theta; // perceptron threshold for training
+    INT32 tau_bypass;
+    INT32 tau_replace;
+  public:
+    PERCEPTRON_POLICY( UINT32 _sets, UINT32 _assoc );
+
+    UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+    void   Checkpoint(FILE *f, bool restore);
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType )
+    {
+	return Get_My_Victim (setIndex, PC, paddr);
+    }
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+    {
+	const UINT8 *x = GetCurrentFeatures(PC, currLine->tag);
+	// Update recent PCs on every access to the cache
+	UpdateRecentPCs(PC);
+        UpdateMyPolicy(setIndex, updateWayID, currLine, x, cacheHit);
+	currFeaturesValid = false;
+    }
+
+  private:
+    PerceptronSet *Set( UINT32 setIndex ) { return (PerceptronSet *) ( sets + setIndex * setBytes ); }
+    PerceptronSamplerEntry &SamplerEntry( UINT32 samplerSetIndex, UINT32 way ) { assert( way < samplerSetAssoc ); return sampler[ samplerSetIndex * samplerSetAssoc + way ]; }
+    INT32  Get_My_Victim( UINT32 setIndex, Addr_t PC, Addr_t paddr );
+    INT32  Get_SamplerLRU_Victim( UINT32 samplerSetIndex );
+    INT32  Get_PseudoLRU_Victim(UINT32 setIndex);
+    void   UpdateMyPolicy( UINT32 setIndex, INT32 updateWayID,const LINE_STATE *currLine, const UINT8 *x, bool cacheHit );
+    void   UpdateSamplerLRU(UINT32 samplerSetIndex, INT32 samplerWayID );
+    void   UpdatePseudoLRU(UINT32 setIndex, INT32 updateWayID );
+    void   UpdateRecentPCs(Addr_t PC);
+    bool   IsSamplerSet(UINT32 setIndex);
+    const UINT8 *GetCurrentFeatures(Addr_t PC, UINT32 tag);
+    INT32  GetPerceptronOutput(const UINT8 *x);
+    void   TrainPerceptron(const UINT8 *x, bool increment);
+    bool   GetPerceptronPredictionBypass(Addr_t PC, UINT32 tag);
+    bool   GetPerceptronPredictionReplacement(Addr_t PC, UINT32 tag);
+    bool   GetPerceptronPredictionBit(const UINT8 *x);
+    INT32  GetPredictionFromSamplerEntry(UINT32 samplerSetIndex, INT32 way);
+    void   UpdatePredictorFromSamplerEntry(UINT32 samplerSetIndex, INT32 way, bool increment);
+    void   UpdateTableEntrySaturatingArithmetic(UINT32 tableNo, UINT32 feature, bool increment);
+
+    INT32   HitInSampler(UINT32 samplerSetIndex, UINT32 tag);
+};
+
+PERCEPTRON_POLICY::PERCEPTRON_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    assert( !(assoc & (assoc - 1)) ); // for the pseudo LRU tree
+    setBytes = (sizeof(plruword) + assoc * sizeof(PERCEPTRON_LINE_STATE) + 31) & ~31;
+    sets  = Carve<char>( numsets * setBytes );
+
+    // values of all parameters are taken directly from the paper
+    // the carved sets start with every prediction bit and pseudo LRU bit 0
+
+    // Initialize Sampler Sets
+    samplerSetNum = 64; // no. of sampler sets
+    samplerSetAssoc = assoc; // a sampler set mirrors its set's ways
+    featureNum = PERCEPTRON_FEATURES; // no. of features for perceptron learning
+    sampler = Carve<PerceptronSamplerEntry>( samplerSetNum * samplerSetAssoc );
+    AssignSetRoles( samplerSetNum, 1, SETS_STRIDED );
+
+    for(UINT32 setIndex=0; setIndex < samplerSetNum; setIndex++){
+	for(UINT32 samplerBlock=0; samplerBlock < samplerSetAssoc; samplerBlock++){
+		SamplerEntry(setIndex, samplerBlock).LRUstackposition = samplerBlock;
+	}
+    }
+
+    // Initialize predictor tables
+    predictorTableEntryNum = PERCEPTRON_TABLE_SIZE;
+    predictorTable = Carve<PerceptronTable>( featureNum );
+    currFeaturesValid = false;
+
+    // Initialize the array holding the recent PCs
+    for(int r=0; r<4; r++){
+ 	recentPCs[r] = 0;
+    }
+
+    // Perceptron parameters
+    theta = 68; // Perceptron training threshold
+    tau_bypass   = 3; // threshold to decide whether to bypass the block
+    tau_replace = 124; // threshold to decide whether to replace the block with incoming block
+}
+
+UINT32 PERCEPTRON_POLICY::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    for(UINT32 table=0; table < featureNum; table++){
+	g[table].s = NULL;
+	g[table].u = NULL;
+	g[table].s8 = predictorTable[table];
+	g[table].n = predictorTableEntryNum;
+	g[table].lo = -32;
+	g[table].hi = 31;
+    }
+    return featureNum;
+}
+
+void PERCEPTRON_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, sets, numsets * setBytes);
+    CheckpointIO(f, restore, sampler, samplerSetNum * samplerSetAssoc * sizeof(PerceptronSamplerEntry));
+    CheckpointIO(f, restore, predictorTable, featureNum * sizeof(PerceptronTable));
+    CheckpointIO(f, restore, recentPCs, 4 * sizeof(Addr_t));
+}
+
+INT32 PERCEPTRON_POLICY::Get_My_Victim( UINT32 setIndex, Addr_t PC, Addr_t paddr ) {
+
+
+
+	// Check if the incoming block is predicted dead and bypass if so
+	UINT32 tag = Tag( paddr );
+	/*
+	if( GetPerceptronPredictionBypass(PC, tag ) ){
+		// update recent PCs right here because update policy won't be called on a bypass
+		UpdateRecentPCs(PC);
+		return -1;
+	}
+
+	// if not bypass, then search for a dead block in the set
+	// i.e Search the set for a block predicted not to have reuse
+	for(UINT32 blk=0; blk < assoc; blk++){
+		// check if this block is dead ie reuse prediction bit is 0 - false
+		if(!Set(setIndex)->line[blk].reusePredictionBit){
+			// check if it must be replaced
+			if(GetPerceptronPredictionReplacement(PC, tag) ){
+				return blk;
+			}
+			//return blk;
+		}
+	}
+
+	// if dead block is not found, then get pseudo LRU victim
+	UINT32 vic = Get_PseudoLRU_Victim(setIndex);
+	Set(setIndex)->line[vic].reusePredictionBit = false;
+	return vic;
+	//return Get_LRU_Victim(setIndex);
+	*/
+
+	// if the set accessed is a sampler set
+	if( IsSamplerSet(setIndex) ){
+		UINT32 samplerSetIndex = SetSlot(setIndex);
+		// need replacement from the sampler set
+		 UINT32 evictedWay = Get_SamplerLRU_Victim(samplerSetIndex);
+		 if( ( (SamplerEntry(samplerSetIndex, evictedWay).Yout) < theta ) ||
+		     ( Set(setIndex)->line[evictedWay].reusePredictionBit ) ){
+		     // misprediction => increment with saturating arithmetic
+		     UpdatePredictorFromSamplerEntry(samplerSetIndex, evictedWay, true); // true is for increment
+		 }
+
+		return evictedWay;
+
+	}
+	// if the set accessed is normal set
+	else {
+	    if( GetPerceptronPredictionBypass(PC, tag ) ){
+		// update recent PCs right here because update policy won't be called on a bypass
+		UpdateRecentPCs(PC);
+		currFeaturesValid = false;
+		return -1;
+	    }
+		// if not bypass, then search for a dead block in the set
+        	// i.e Search the set for a block predicted not to have reuse
+	    for(UINT32 blk=0; blk < assoc; blk++){
+		// check if this block is dead ie reuse prediction bit is 0 - false
+		if(!Set(setIndex)->line[blk].reusePredictionBit){
+			// check if it must be replaced
+			//if(GetPerceptronPredictionReplacement(PC, tag) ){
+				return blk;
+			//}
+			//return blk;
+		}
+  	    }
+
+        	return Get_PseudoLRU_Victim(setIndex);
+
+	}
+}
+INT32 PERCEPTRON_POLICY::Get_SamplerLRU_Victim( UINT32 samplerSetIndex ){
+// Get pointer to replacement state of current set
+
+	INT32   lruWay   = 0;
+
+	// Search for victim whose stack position is assoc-1
+
+	for(UINT32 way=0; way<samplerSetAssoc; way++) {
+		if (SamplerEntry(samplerSetIndex, way).LRUstackposition == (samplerSetAssoc-1)) {
+			lruWay = way;
+			break;
+		}
+	}
+
+	// return lru way
+
+	return lruWay;
+
+}
+INT32 PERCEPTRON_POLICY:: Get_PseudoLRU_Victim(UINT32 setIndex){
+	return plru_victim(Set(setIndex)->pseudoLRU, assoc);
+}
+
+void PERCEPTRON_POLICY::UpdateMyPolicy( UINT32 setIndex, INT32 updateWayID,const LINE_STATE *currLine, const UINT8 *x, bool cacheHit ) {
+
+	UINT32 tag = currLine->tag ;
+
+
+
+	// Training the predictor
+	// Check if this is sampler set
+	if( IsSamplerSet(setIndex) ){
+
+		/*
+		INT32 updateWay = 0;
+		INT32 samplerHitWay = HitInSampler(samplerSetIndex, tag);
+		// if hit in sampler
+		if(samplerHitWay != -1){
+			//printf("##################### Hit in Sampler ######################\n");
+			// if the Yout for this entry exceeds a threshold, the predictor table entries
+			// indexed by hashes in the accessed sampler entry are decremented with saturating arithmetic
+			if( ((SamplerEntry(samplerSetIndex, samplerHitWay).Yout) > -theta )){
+				//printf("Updating on sampler hit\n");
+				UpdatePredictorFromSamplerEntry(samplerSetIndex, samplerHitWay, false); // false is for decrement
+				//UpdatePredictorFromRecentPCs(tag, false);
+
+			}
+			updateWay = samplerHitWay;
+
+		} // if miss in the sampler
+		else{
+			//printf("############## Miss in the sampler set %u ##############\n",samplerSetIndex);
+			UINT32 evictedWay = 0;// Get_SamplerLRU_Victim(samplerSetIndex);
+			bool needReplacement = true;
+			for(UINT32 way=0; way < samplerSetAssoc; way++){
+				if( !SamplerEntry(samplerSetIndex, way).valid ){
+				  	evictedWay = way;
+					needReplacement = false;
+					break;
+				}
+			}
+
+			if(needReplacement){
+			    evictedWay = Get_SamplerLRU_Victim(samplerSetIndex);
+			    if( ( (SamplerEntry(samplerSetIndex, evictedWay).Yout) < theta ) ||
+			        ( Set(setIndex)->line[updateWayID].reusePredictionBit ) ){
+				// misprediction => increment with saturating arithmetic
+				UpdatePredictorFromSamplerEntry(samplerSetIndex, evictedWay, true); // true is for increment
+			    }
+
+
+
+
+			}
+			//Set(setIndex)->line[updateWayID].reusePredictionBit = false;
+			updateWay = evictedWay;
+
+
+
+
+
+		}
+		*/
+		UINT32 samplerSetIndex = SetSlot(setIndex);
+		if( cacheHit ){
+			if( ((SamplerEntry(samplerSetIndex, updateWayID).Yout) > -theta )){
+				//printf("Updating on sampler hit\n");
+				UpdatePredictorFromSamplerEntry(samplerSetIndex, updateWayID, false); // false is for decrement
+
+			}
+
+		}else{
+
+			// Place the new features in the sampled entry
+			UINT32 mask15 = (1 << 15) - 1;
+			SamplerEntry(samplerSetIndex, updateWayID).partialTag = (tag & mask15 );
+			// fill the feature list with this access's
+			memcpy(SamplerEntry(samplerSetIndex, updateWayID).features, x, PERCEPTRON_FEATURES);
+
+			// calculate yout
+			SamplerEntry(samplerSetIndex, updateWayID).Yout = GetPerceptronOutput(x);
+			SamplerEntry(samplerSetIndex, updateWayID).valid = true;
+		}
+
+		// Update sampler lru now
+		UpdateSamplerLRU(samplerSetIndex, updateWayID);
+
+	} // a normal set
+	else{
+		UpdatePseudoLRU(setIndex, updateWayID);
+	}
+
+	Set(setIndex)->line[updateWayID].reusePredictionBit = GetPerceptronPredictionBit(x);
+
+}
+void PERCEPTRON_POLICY::UpdateSamplerLRU(UINT32 samplerSetIndex, INT32 samplerWayID ){
+
+	// Determine current LRU stack position
+	UINT32 currLRUstackposition = SamplerEntry(samplerSetIndex, samplerWayID).LRUstackposition;
+
+	// Update the stack position of all lines before the current line
+	// Update implies incremeting their stack positions by one
+
+	for(UINT32 way=0; way<samplerSetAssoc; way++) {
+		if( SamplerEntry(samplerSetIndex, way).LRUstackposition < currLRUstackposition ) {
+			SamplerEntry(samplerSetIndex, way).LRUstackposition++;
+		}
+	}
+
+	// Set the LRU stack position of new line to be zero
+	SamplerEntry(samplerSetIndex, samplerWayID).LRUstackposition = 0;
+
+
+}
+
+/*
+   The following description of Tree Pseudo LRU policy is taken from an internet search.
+   The method that follows is my own implementation
+   TREE PSEUDO LRU Policy
+              are all 4 lines valid?
+                   /       \
+                 yes        no, use an invalid line
+                  |
+                  |
+                  |
+             bit_0 == 0?            state | replace      ref to | next state
+              /       \             ------+--------      -------+-----------
+             y         n             00x  |  line_0      line_0 |    11_
+            /           \            01x  |  line_1      line_1 |    10_
+     bit_1 == 0?    bit_2 == 0?      1x0  |  line_2      line_2 |    0_1
+       /    \          /    \        1x1  |  line_3      line_3 |    0_0
+      y      n        y      n
+     /        \      /        \        ('x' means       ('_' means unchanged)
+   line_0  line_1  line_2  line_3
+    (3)      (4)     (5)    (6)
+
+
+    the tree is represented as the bits of a word in this implementation(for a 4 way associativity)
+    pseudoLRU = bit_2 bit_1 bit_0
+    Leaves are the lines to be evicted = [line_0, line_1, line_2, line_3]
+    The lines can be thought of as parts of the tree with continued indices:
+    line_0 = 3, line_1 = 4 and so on.
+*/
+// Updates Pseudo LRU data for non sampler sets
+void PERCEPTRON_POLICY::UpdatePseudoLRU(UINT32 setIndex, INT32 updateWayID ){
+	Set(setIndex)->pseudoLRU = plru_touch(Set(setIndex)->pseudoLRU, assoc, updateWayID);
+}
+
+// shifts the recentPCs array to higher indices
+// a[3] = a[2], a[3] = a[2],.. so on. a[0] = PC
+void PERCEPTRON_POLICY::UpdateRecentPCs(Addr_t PC){
+	// shift the PCs to higher index
+	for(int i=3; i > 0; i--){
+		recentPCs[i] = recentPCs[i-1];
+	}
+	// shift in the lates PC passed as argument to this function
+	recentPCs[0] = PC;
+
+	// Print them for debug
+	/*
+	for(int i=0; i < 4; i++){
+		printf("recentPCs[%d] = %llx\n",i,recentPCs[i]);
+	}*/
+
+}
+// returns true if setIndex is a sampler set,otherwise return false
+bool PERCEPTRON_POLICY::IsSamplerSet(UINT32 setIndex){
+	return SetRole(setIndex) != SET_FOLLOWER;
+}
+// The hashed features of an access by PC to tag, the index of each in its
+// table: the PC itself, the 3 PCs before it, and two pieces of the tag,
+// each hashed with the PC.  They are computed from recentPCs before it is
+// updated for this access, and once per access.
+const UINT8 *PERCEPTRON_POLICY::GetCurrentFeatures(Addr_t PC, UINT32 tag){
+	if(currFeaturesValid && currFeaturesTag == tag){
+		return currFeatures;
+	}
+	UINT32 hmask = ((1<<8)-1);
+	UINT8 *x = currFeatures;
+	x[0] = ( (PC >> 2) & hmask ) ^ (PC & hmask); // 1st feature PC0
+	x[1] = ( (recentPCs[0] >> 1) & hmask ) ^ (PC & hmask); // 2nd feature PC1
+	x[2] = ( (recentPCs[1] >> 2) & hmask ) ^ (PC & hmask); // 3rd feature PC2
+	x[3] = ( (recentPCs[2] >> 3) & hmask ) ^ (PC & hmask); // 4th feature PC3
+	x[4] = ( (tag >> 4) & hmask ) ^ (PC & hmask); // 5th feature current tag>>4
+	x[5] = ( (tag >> 7) & hmask ) ^ (PC & hmask); // 6th feature current tag>>7
+	currFeaturesValid = true;
+	currFeaturesTag = tag;
+	return x;
+}
+// Sums the weights of features x, one from each table.  With byte weights
+// in one block, a gather instruction would only slow the 6 loads down.
+INT32 PERCEPTRON_POLICY::GetPerceptronOutput(const UINT8 *x){
+	return predictorTable[0][x[0]] + predictorTable[1][x[1]] + predictorTable[2][x[2]] +
+	       predictorTable[3][x[3]] + predictorTable[4][x[4]] + predictorTable[5][x[5]];
+}
+// Moves the weights of features x one step up or down
+void PERCEPTRON_POLICY::TrainPerceptron(const UINT8 *x, bool increment){
+	for(UINT32 f=0; f < featureNum; f++){
+		UpdateTableEntrySaturatingArithmetic(f, x[f], increment);
+	}
+}
+// true if the block the access brings in should bypass the cache
+bool PERCEPTRON_POLICY::GetPerceptronPredictionBypass(Addr_t PC, UINT32 tag){
+	return (GetPerceptronOutput(GetCurrentFeatures(PC, tag)) > tau_bypass);
+}
+// Returns the prediction for replacement
+bool  PERCEPTRON_POLICY::GetPerceptronPredictionReplacement(Addr_t PC, UINT32 tag){
+	return (GetPerceptronOutput(GetCurrentFeatures(PC, tag)) > tau_replace);
+}
+// returns true if the block is predicted reuse and false if predicted dead
+bool  PERCEPTRON_POLICY::GetPerceptronPredictionBit(const UINT8 *x){
+	return  (GetPerceptronOutput(x) < tau_replace);
+}
+// Calculates Yout for the features a sampler set entry
+INT32 PERCEPTRON_POLICY::GetPredictionFromSamplerEntry(UINT32 samplerSetIndex, INT32 way){
+	return GetPerceptronOutput(SamplerEntry(samplerSetIndex, way).features);
+}
+
+// Updates the predictor entries using the features in sampler set entry
+// increment = true => entries are incremented and decremented otherwise
+void PERCEPTRON_POLICY::UpdatePredictorFromSamplerEntry(UINT32 samplerSetIndex, INT32 way, bool increment){
+	TrainPerceptron(SamplerEntry(samplerSetIndex, way).features, increment);
+}
+// Increments table entries with saturating arithmetic
+// if increment=true, increments the entry if < 31, otherwise decrements if > -32
+void PERCEPTRON_POLICY::UpdateTableEntrySaturatingArithmetic(UINT32 tableNo, UINT32 feature, bool increment){
+	if(increment){
+		if(predictorTable[tableNo][feature] < 31){
+			predictorTable[tableNo][feature]++;
+		}
+	}else{
+		if(predictorTable[tableNo][feature] > -32){
+			predictorTable[tableNo][feature]--;
+		}
+	}
+}
+// Returns -1 if there is a miss in the sampler and returns way number if there is a hit
+INT32 PERCEPTRON_POLICY:: HitInSampler(UINT32 samplerSetIndex, UINT32 tag){
+	UINT32 mask15 = ((1<<15)-1);
+	for(UINT32 way=0; way < samplerSetAssoc; way++){
+		if(SamplerEntry(samplerSetIndex, way).valid && ( SamplerEntry(samplerSetIndex, way).partialTag == (tag & mask15) ) ){
+			return way;
+		}
+	}
+
+	return -1;
+}
+
+static CACHE_REPLACEMENT_STATE *make_perceptron (UINT32 sets, UINT32 assoc) {
+	return new PERCEPTRON_POLICY (sets, assoc);
+}
+
+REGISTER_POW2_POLICY ("perceptron", make_perceptron, repl_hooks<PERCEPTRON_POLICY>, "perceptron reuse prediction with bypass, over tree pseudo-LRU")
@@ -0,0 +1,215 @@
+#include "cache_access.h"
+#include "rrip.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Re-Reference Interval Prediction (A.Jaleel, K.B. Theobald, S.C Steely Jr., //
+// J. Emer): static RRIP in every set, or dynamic RRIP, set dueling between   //
+// SRRIP and bimodal RRIP.                                                    //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+// the roles of the sets, from AssignSetRoles
+typedef enum {
+    RRIP_SD_SRRIP = SET_ROLE_A,
+    RRIP_SD_BRRIP = SET_ROLE_B,
+    RRIP_SD_FOLLOWER = SET_FOLLOWER,
+} RRIPSetDedicationType;
+
+class RRIP_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    rripset   *repl; // RRPVs, M bits each
+    UINT32    groups; // rripsets per set
+
+    bool duel;  // false for SRRIP in every set
+
+    UINT32 M;      // RRIP parameter M. M Bits are used to store RRPV value for each cache block
+    UINT32 DIST_RRPV; // equals 2^M - 1
+    UINT32 LONG_RRPV; // equals 2^M - 2
+    UINT32 misses; // counts number of misses
+    UINT32 BRRIP_frequency;
+
+    // parameters for DRRIP
+    // No. of Sets dedicated to each policy in Set Dueling
+    UINT32 K;
+
+    /*Follower Set Eviction Policy Selector: if MSB(PSEL) is 1, then BRRIP, otherwise SRRIP
+      If Miss incurred in SRRIP dedicated sets, increment PSEL.
+      If Miss incurred in BRRIP dedicated sets, decrement PSEL.
+    */
+    UINT32 PSEL;
+    UINT32 PSEL_bits; // no of bits for PSEL counter
+
+    // way's RRPV in set setIndex
+    UINT8 &RRPV( UINT32 setIndex, INT32 way ) { return rrip_rrpv( repl, setIndex, groups )[ way ]; }
+
+  public:
+    RRIP_POLICY( UINT32 _sets, UINT32 _assoc, bool _duel, UINT32 _M );
+
+    UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+    void   Checkpoint(FILE *f, bool restore);
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType );
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit );
+
+  private:
+    void   UpdateSRRIP(UINT32 setIndex, INT32 updateWayID, bool cacheHit); // SRRIP update
+    void   UpdateBRRIP(UINT32 setIndex, INT32 updateWayID, bool cacheHit); // BRRIP update
+};
+
+RRIP_POLICY::RRIP_POLICY( UINT32 _sets, UINT32 _assoc, bool _duel, UINT32 _M ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    duel = _duel;
+
+    K = 32; // No. Of sets dedicated to each policy
+    // dedicate K sets to each policy by complement-select
+    if(duel) AssignSetRoles(K, 2, SETS_COMPLEMENT);
+
+    // Initialize policy selector to 0
+    PSEL = 0;
+
+  // Set PSEL bits
+    PSEL_bits = 10;
+
+    M = _M; // Bits to store RRPV for SRRIP (Static Re-Reference Interval Predictor)
+    DIST_RRPV = ( (1<<M) - 1);
+    LONG_RRPV = ( (1<<M) - 2);
+
+    // Initialize RRPV values for all lines in all sets
+    groups = rrip_groups( assoc );
+    repl  = Carve<rripset>( numsets * groups );
+    for(UINT32 setIndex=0; setIndex<numsets; setIndex++)
+    {
+        for(UINT32 way=0; way<assoc; way++)
+        {
+            RRPV(setIndex, way) = DIST_RRPV; // Initialize all lines with 2^M - 1 DIST_RRPV value of RRPV
+        }
+    }
+
+    misses = 0;
+    BRRIP_frequency = 64; // frequency with which BRRIP places incoming blocks at LONG_RRPV re-reference interval
+
+    // note: K = 32, M=4, BRRIP_frequency = 64 gives 1.025 IPC gmean
+}
+
+UINT32 RRIP_POLICY::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    if (!duel) return 0;
+    g[0].s = NULL;
+    g[0].u = &PSEL;
+    g[0].s8 = NULL;
+    g[0].n = 1;
+    g[0].lo = 0;
+    g[0].hi = (1<<PSEL_bits)-1;
+    return 1;
+}
+
+void RRIP_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, repl, numsets * groups * sizeof(rripset));
+    CheckpointIO(f, restore, &PSEL, sizeof(PSEL));
+    CheckpointIO(f, restore, &misses, sizeof(misses));
+}
+
+INT32 RRIP_POLICY::GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType ) {
+	// the first block with distant RRPV, aging the set until there is one
+	return rrip_victim(&repl[setIndex * groups], assoc, DIST_RRPV);
+}
+
+void RRIP_POLICY::UpdateReplacementState(
+    UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+    UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+{
+	if(!cacheHit){
+		misses++;
+	}
+
+	// without dueling every set is SRRIP
+	if(!duel){
+		UpdateSRRIP(setIndex, updateWayID, cacheHit);
+		return;
+	}
+	UINT32 dedication = SetRole(setIndex);
+
+        // if the set dedication of this set is SRRIP update SRRIP
+        if(dedication == RRIP_SD_SRRIP){
+		UpdateSRRIP(setIndex, updateWayID, cacheHit);
+		// if this is a miss, increment PSEL, by as many leader sets as
+		// this one stands for
+		if(!cacheHit){
+			PSEL = PSEL + roleWeight < (UINT32)((1<<PSEL_bits)-1) ? PSEL + roleWeight : (1<<PSEL_bits)-1;
+		}
+
+	}
+	// if the set dedication of this set is BRRIP update BRRIP
+	else if(dedication == RRIP_SD_BRRIP){
+		UpdateBRRIP(setIndex, updateWayID, cacheHit);
+		if(!cacheHit){
+			PSEL = PSEL > roleWeight ? PSEL - roleWeight : 0;
+		}
+	}
+	// if the set is a follower, update according to PSEL
+	else{
+		// select the policy depending on the MSB of PSEL
+		if( (((PSEL >> (PSEL_bits - 1))&1) == 1)){
+		  	// MSB is 1, use BRRIP policy
+			UpdateBRRIP(setIndex, updateWayID, cacheHit);
+		}else{
+			// MSB is 0, use SRRIP policy
+			UpdateSRRIP(setIndex, updateWayID, cacheHit);
+		}
+	}
+
+}
+
+void RRIP_POLICY::  UpdateSRRIP(UINT32 setIndex, INT32 updateWayID, bool cacheHit){ // SRRIP update
+// If the access is a miss, then RRPV for this block is LONG_RRPV
+	if( !cacheHit){
+		RRPV(setIndex, updateWayID) = LONG_RRPV;
+	}
+	/* If the access is a hit, then RRPV for this block is decremented as required by RRIP-FP policy (Re-Reference Interval Prediction - Frequency Priority)
+	 * This makes sure that the blocks that are frequently hit have lower RRPV value.
+	 */
+	else {
+		if(RRPV(setIndex, updateWayID) > 0){
+			RRPV(setIndex, updateWayID)--;
+		}
+	}
+}
+
+void RRIP_POLICY::  UpdateBRRIP(UINT32 setIndex, INT32 updateWayID, bool cacheHit){ // BRRIP update
+	if(!cacheHit){
+		// infrequenntly place the incoming block in LONG_RRPV
+		if(Random()%100 < 100.0/BRRIP_frequency){
+			misses = 0;
+			RRPV(setIndex, updateWayID) = LONG_RRPV;
+		}else{
+			// place majority with DIST_RRPV
+			RRPV(setIndex, updateWayID) = DIST_RRPV;
+
+		}
+	}
+	else{
+		if(RRPV(setIndex, updateWayID) > 0){
+			RRPV(setIndex, updateWayID)--;
+		}
+
+	}
+}
+
+static CACHE_REPLACEMENT_STATE *make_srrip (UINT32 sets, UINT32 assoc) {
+	return new RRIP_POLICY (sets, assoc, false, 2);
+}
+
+// DRRIP was tuned with 1-bit RRPVs
+
+static CACHE_REPLACEMENT_STATE *make_drrip (UINT32 sets, UINT32 assoc) {
+	return new RRIP_POLICY (sets, assoc, true, 1);
+}
+
+REGISTER_POLICY ("drrip", make_drrip, repl_hooks<RRIP_POLICY>, "dynamic RRIP: set dueling between SRRIP and bimodal RRIP")
+REGISTER_POLICY ("srrip", make_srrip, repl_hooks<RRIP_POLICY>, "static re-reference interval prediction, 2-bit RRPVs")
@@ -0,0 +1,143 @@
+#include "cache_access.h"
+#include "rrip.h"
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Signature-based Hit Predictor (C.-J. Wu et. al.) with baseline SRRIP.      //
+// A table of counters indexed by a signature of the filling PC learns, from  //
+// a sample of sets, whether the blocks a PC fills are hit again; fills by    //
+// PCs it predicts never are inserted at distant RRPV.                        //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+// an entry of a sampler set; a 16-way sampler set is 64 bytes
+
+struct SHIPSamplerEntry{
+
+    UINT16 signature; // signature of the PC that filled the entry
+    bool outcome;     // whether the entry has been hit since
+};
+
+class SHIP_POLICY : public CACHE_REPLACEMENT_STATE
+{
+  private:
+    rripset   *repl; // RRPVs, M bits each
+    UINT32    groups; // rripsets per set
+
+    UINT32* SHCT; // Signature History Counter Table
+    UINT32 SHCT_size; // size of SHCT table
+
+    UINT32 M;      // RRIP parameter M. M Bits are used to store RRPV value for each cache block
+    UINT32 DIST_RRPV; // equals 2^M - 1
+    UINT32 LONG_RRPV; // equals 2^M - 2
+
+    SHIPSamplerEntry* sampler; // sampler[set*assoc+way]
+    UINT32 samplerSize;  // number of sampler sets
+
+    // way's RRPV in set setIndex
+    UINT8 &RRPV( UINT32 setIndex, INT32 way ) { return rrip_rrpv( repl, setIndex, groups )[ way ]; }
+
+  public:
+    SHIP_POLICY( UINT32 _sets, UINT32 _assoc );
+
+    UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+    void   Checkpoint(FILE *f, bool restore);
+
+    INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType );
+
+    void   UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                   UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit );
+};
+
+SHIP_POLICY::SHIP_POLICY( UINT32 _sets, UINT32 _assoc ) : CACHE_REPLACEMENT_STATE( _sets, _assoc )
+{
+    groups = rrip_groups( assoc );
+    repl  = Carve<rripset>( numsets * groups );
+
+    SHCT_size = 16*1024; // 16K entry table
+    SHCT = Carve<UINT32>( SHCT_size );
+
+    M = 2; // Bits to store RRPV for SRRIP (Static Re-Reference Interval Predictor)
+    DIST_RRPV = ( (1<<M) - 1);
+    LONG_RRPV = ( (1<<M) - 2);
+
+    samplerSize = SamplerSets( 64 );
+    AssignSetRoles( samplerSize, 1, SETS_STRIDED );
+
+    sampler = Carve<SHIPSamplerEntry>( samplerSize * assoc );
+}
+
+UINT32 SHIP_POLICY::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    g[0].s = NULL;
+    g[0].u = SHCT;
+    g[0].s8 = NULL;
+    g[0].n = SHCT_size;
+    g[0].lo = 0;
+    g[0].hi = 7;
+    return 1;
+}
+
+void SHIP_POLICY::Checkpoint(FILE *f, bool restore)
+{
+    CACHE_REPLACEMENT_STATE::Checkpoint(f, restore);
+    CheckpointIO(f, restore, repl, numsets * groups * sizeof(rripset));
+    CheckpointIO(f, restore, SHCT, SHCT_size * sizeof(UINT32));
+    CheckpointIO(f, restore, sampler, samplerSize * assoc * sizeof(SHIPSamplerEntry));
+}
+
+INT32 SHIP_POLICY::GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType ) {
+	// the first block with distant RRPV, aging the set until there is one
+	return rrip_victim(&repl[setIndex * groups], assoc, DIST_RRPV);
+}
+
+void SHIP_POLICY::UpdateReplacementState(
+    UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+    UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit )
+{
+	UINT32 signature = (PC & ((1<<14)-1));
+	if(cacheHit){
+
+		if(RRPV(setIndex, updateWayID) >0){
+			RRPV(setIndex, updateWayID)--;
+		}
+	}else{
+		if(SHCT[signature] == 0){
+			RRPV(setIndex, updateWayID) = DIST_RRPV;
+		}else{
+			RRPV(setIndex, updateWayID) = LONG_RRPV;
+		}
+
+	}
+
+	// return if the access is not to the sampled set
+
+	if( SetRole(setIndex) == SET_FOLLOWER ) {
+		return;
+	}
+	setIndex = SetSlot(setIndex);
+	SHIPSamplerEntry *e = &sampler[ setIndex * assoc + updateWayID ];
+	if(cacheHit){
+		e->outcome = true;
+		if(SHCT[ e->signature ] < 7){
+		   SHCT[ e->signature ]++;
+		}
+
+	}
+	else{
+		if( !e->outcome ){
+			if(SHCT[ e->signature ] > 0){
+			   SHCT[ e->signature ]--;
+			}
+		}
+		e->outcome = false;
+		e->signature = signature;
+
+	}
+}
+
+static CACHE_REPLACEMENT_STATE *make_ship (UINT32 sets, UINT32 assoc) {
+	return new SHIP_POLICY (sets, assoc);
+}
+
+REGISTER_POLICY ("ship", make_ship, repl_hooks<SHIP_POLICY>, "signature-based hit prediction over SRRIP")
@@ -0,0 +1,263 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <iostream>
+#include <algorithm>
+
+using namespace std;
+
+#include "replacement_state.h"
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is distributed as part of the Cache Replacement Championship     //
+// workshop held in conjunction with ISCA'2010.                               //
+//                                                                            //
+//                                                                            //
+// Everyone is granted permission to copy, modify, and/or re-distribute       //
+// this software.                                                             //
+//                                                                            //
+// Please contact Aamer Jaleel <ajaleel@gmail.com> should you have any        //
+// questions                                                                  //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+/*
+** This file implements the replacement state every policy shares.  The
+** policies themselves are in policy_*.cpp; see policy.h.
+**
+*/
+
+
+////////////////////////////////////////////////////////////////////////////////
+// The replacement state constructor:                                         //
+// Inputs: number of sets and associativity                                   //
+// Outputs: None                                                              //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+CACHE_REPLACEMENT_STATE::CACHE_REPLACEMENT_STATE( UINT32 _sets, UINT32 _assoc )
+{
+
+    numsets    = _sets;
+    assoc      = _assoc;
+
+    mytimer    = 0;
+
+    SetGeometry( 64, 0 );
+
+    arenaNext  = NULL;
+    arenaLeft  = 0;
+    arenaGrow  = 0;
+
+    setRoles   = NULL;
+    roleWeight = 1;
+
+    SeedRandom( 0 );
+
+    // initialize stack positions (for true LRU), a word per set if they fit
+    assert( assoc >= 1 && assoc <= LRU_WIDE_MAX_ASSOC );
+    lru     = NULL;
+    lruWide = NULL;
+    if( assoc <= LRU_MAX_ASSOC ) {
+        lru = Carve<lruword>( numsets );
+        for(UINT32 setIndex=0; setIndex<numsets; setIndex++)
+            lru[ setIndex ] = lru_init( assoc );
+    } else {
+        lruWide = Carve<UINT8>( numsets * assoc );
+        for(UINT32 setIndex=0; setIndex<numsets; setIndex++)
+            lru_wide_init( &lruWide[ setIndex * assoc ], assoc );
+    }
+}
+
+CACHE_REPLACEMENT_STATE::~CACHE_REPLACEMENT_STATE (void) {
+    for(size_t i=0; i<arenaChunks.size(); i++) free( arenaChunks[i] );
+}
+
+// splitmix64's finalizer, so that nearby seeds start far apart; xorshift
+// never leaves 0, so that is skipped
+
+void CACHE_REPLACEMENT_STATE::SeedRandom( UINT64 seed )
+{
+    UINT64 x = seed + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    randState = (x ^ (x >> 31)) | 1;
+}
+
+void CACHE_REPLACEMENT_STATE::SetGeometry( UINT32 blocksize, UINT32 _setShift )
+{
+    blockOffsetBits = __builtin_ctz( blocksize );
+    setBits         = __builtin_ctz( numsets ); // with a power of two sets
+    setShift        = _setShift;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// The arena is a list of chunks.  An allocation comes from the last chunk,   //
+// or a new one if it doesn't fit.  Chunks start small and double up to 4MB,  //
+// so a small state, like a miniature cache's or a shard's, stays small.  A   //
+// chunk of 2MB or more is aligned to a huge page and a multiple of 2MB, so   //
+// that with hugePages the kernel can back it with huge pages.                //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+#define ARENA_ALIGN	64
+#define ARENA_PAGE	(2 << 20)
+#define ARENA_MIN_CHUNK	(64 << 10)
+#define ARENA_CHUNK	(4 << 20)
+
+bool CACHE_REPLACEMENT_STATE::hugePages = false;
+
+void *CACHE_REPLACEMENT_STATE::ArenaAlloc( size_t bytes )
+{
+    bytes = (bytes + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+    if( bytes > arenaLeft ) {
+        arenaGrow = arenaGrow ? min( 2 * arenaGrow, (size_t) ARENA_CHUNK ) : ARENA_MIN_CHUNK;
+        size_t size = max( bytes, arenaGrow );
+        bool huge = size >= ARENA_PAGE;
+        if( huge ) size = (size + ARENA_PAGE - 1) & ~(size_t) (ARENA_PAGE - 1);
+        void *p;
+        if( posix_memalign( &p, huge ? ARENA_PAGE : ARENA_ALIGN, size ) ) {
+            fprintf( stderr, "out of memory for replacement state\n" );
+            exit( 1 );
+        }
+        if( huge && hugePages ) madvise( p, size, MADV_HUGEPAGE );
+        memset( p, 0, size );
+        arenaChunks.push_back( (char *) p );
+        arenaNext = (char *) p;
+        arenaLeft = size;
+    }
+    void *p = arenaNext;
+    arenaNext += bytes;
+    arenaLeft -= bytes;
+    return p;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// Set roles for sampling and set dueling.  Strided takes every nsets/n'th    //
+// set, with the second role halfway between.  Complement-select, from DIP    //
+// (Qureshi et. al.), divides the sets into n constituencies and in each one  //
+// takes the set whose offset equals the constituency for the first role and  //
+// the one whose offset is its complement for the second.  Random takes a     //
+// shuffle of the sets from a fixed seed, so every run picks the same ones.   //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+int CACHE_REPLACEMENT_STATE::setSelect = -1;
+UINT32 CACHE_REPLACEMENT_STATE::miniature = 1;
+UINT32 CACHE_REPLACEMENT_STATE::setSample = 1;
+const char *CACHE_REPLACEMENT_STATE::setSelectNames[SETS_SCHEMES] = { "strided", "complement", "random" };
+
+// a shuffle from a fixed seed, so the LLCs and their shards all sample
+// the same sets, in order so that AssignSetRoles spreads roles over them
+
+void CACHE_REPLACEMENT_STATE::ChooseSampledSets( UINT32 nsets, UINT32 n, UINT32 *sets )
+{
+    vector<UINT32> order( nsets );
+    for(UINT32 s=0; s<nsets; s++) order[ s ] = s;
+    UINT64 x = 0x2545f4914f6cdd1dULL;
+    for(UINT32 i=0; i<nsets/n; i++) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        swap( order[ i ], order[ i + x % (nsets - i) ] );
+    }
+    sort( order.begin(), order.begin() + nsets/n );
+    copy( order.begin(), order.begin() + nsets/n, sets );
+}
+
+// the roles go to the sets that are simulated, live[0] through
+// live[sets-1]: all of them, or with set sampling the sampled ones
+
+void CACHE_REPLACEMENT_STATE::AssignSetRoles( UINT32 n, UINT32 nroles, int scheme )
+{
+    UINT32 sets = numsets / setSample;
+    vector<UINT32> live( sets );
+    if( setSample > 1 ) ChooseSampledSets( numsets, setSample, &live[0] );
+    else for(UINT32 s=0; s<sets; s++) live[ s ] = s;
+
+    UINT32 asked = n;
+    if( setSelect >= 0 ) scheme = setSelect;
+    if( n > sets / nroles ) n = sets / nroles;
+    if( (miniature > 1 || setSample > 1) && n > sets / (2 * nroles) ) n = max( sets / (2 * nroles), 1u );
+    // complement-select needs a power of two sets, and has a set per
+    // constituency only with no more constituencies than sets in each
+    if( scheme == SETS_COMPLEMENT && (sets & (sets - 1)) ) scheme = SETS_STRIDED;
+    if( scheme == SETS_COMPLEMENT ) while( n * n > sets ) n /= 2;
+    assert( n > 0 && n <= 0x3fff && nroles <= 2 );
+    roleWeight = asked / n;
+    if( !setRoles ) setRoles = Carve<UINT16>( numsets );
+    memset( setRoles, 0, numsets * sizeof(UINT16) );
+
+    if( scheme == SETS_STRIDED ) {
+        UINT32 stride = sets / n;
+        for(UINT32 i=0; i<n; i++) {
+            setRoles[ live[ i * stride ] ] = (SET_ROLE_A << 14) | i;
+            if( nroles == 2 ) setRoles[ live[ i * stride + stride / 2 ] ] = (SET_ROLE_B << 14) | i;
+        }
+    } else if( scheme == SETS_COMPLEMENT ) {
+        UINT32 Kbits      = __builtin_ctz( n );
+        UINT32 offsetbits = __builtin_ctz( sets ) - Kbits;
+        UINT32 mask       = (1 << offsetbits) - 1;
+        for(UINT32 s=0; s<sets; s++) {
+            UINT32 constituency = s >> offsetbits;
+            if( constituency == (s & mask) )
+                setRoles[ live[ s ] ] = (SET_ROLE_A << 14) | constituency;
+            else if( nroles == 2 && constituency == (~s & mask) )
+                setRoles[ live[ s ] ] = (SET_ROLE_B << 14) | constituency;
+        }
+    } else {
+        vector<UINT32> order( sets );
+        for(UINT32 s=0; s<sets; s++) order[ s ] = s;
+        UINT64 x = 0x9e3779b97f4a7c15ULL;
+        for(UINT32 i=0; i<n*nroles; i++) {
+            // xorshift from a fixed seed, so every state picks the same sets
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            swap( order[ i ], order[ i + x % (sets - i) ] );
+            setRoles[ live[ order[ i ] ] ] = ((i < n ? SET_ROLE_A : SET_ROLE_B) << 14) | (i % n);
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// The function prints the statistics for the cache                           //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+ostream & CACHE_REPLACEMENT_STATE::PrintStats(ostream &out)
+{
+
+    out<<"=========================================================="<<endl;
+    out<<"=========== Replacement Policy Statistics ================"<<endl;
+    out<<"=========================================================="<<endl;
+
+    return out;
+
+}
+
+UINT32 CACHE_REPLACEMENT_STATE::GetGlobalCounters(GLOBAL_COUNTERS *g)
+{
+    return 0;
+}
+
+void CACHE_REPLACEMENT_STATE::Checkpoint(FILE *f, bool restore)
+{
+    if( lru ) CheckpointIO(f, restore, lru, numsets * sizeof(lruword));
+    else CheckpointIO(f, restore, lruWide, numsets * assoc);
+    CheckpointIO(f, restore, &mytimer, sizeof(mytimer));
+    CheckpointIO(f, restore, &randState, sizeof(randState));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This function finds a random victim in the cache set                       //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+INT32 CACHE_REPLACEMENT_STATE::Get_Random_Victim( UINT32 setIndex )
+{
+    INT32 way = (Random() % assoc);
+    
+    return way;
+}
@@ -0,0 +1,194 @@
+#ifndef REPL_STATE_H
+#define REPL_STATE_H
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+//                                                                            //
+// This file is distributed as part of the Cache Replacement Championship     //
+// workshop held in conjunction with ISCA'2010.                               //
+//                                                                            //
+//                                                                            //
+// Everyone is granted permission to copy, modify, and/or re-distribute       //
+// this software.                                                             //
+//                                                                            //
+// Please contact Aamer Jaleel <ajaleel@gmail.com> should you have any        //
+// questions                                                                  //
+//                                                                            //
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <cassert>
+#include "utils.h"
+#include "crc_cache_defs.h"
+#include "lru.h"
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// the roles AssignSetRoles gives sets: most are followers, and the rest
+// are sampled, or lead for one of two dueling policies
+
+#define SET_FOLLOWER	0
+#define SET_ROLE_A	1
+#define SET_ROLE_B	2
+
+// how AssignSetRoles spreads its sets over the cache
+
+enum {
+    SETS_STRIDED,	// evenly, from set 0
+    SETS_COMPLEMENT,	// DIP's complement-select
+    SETS_RANDOM,	// a fixed pseudo-random choice
+    SETS_SCHEMES
+};
+
+// What every replacement policy has in common.  Each policy is a subclass
+// in its own policy_*.cpp that registers itself under a name (see
+// policy.h), keeping its per-line and global state as fields of its own.
+// All of them get true LRU stacks for free: the cache's LRU policy uses
+// them, and so do the policies that fall back on LRU order.
+//
+// A policy carves its per-set and sampler state out of the replacement
+// state's arena with Carve rather than allocating it set by set, so each
+// table is one zeroed, cache-line aligned array in a few chunks.  With
+// a 32MB LLC that is half a million sets, and allocating them one at a
+// time makes startup slow and scatters them over the TLB.
+
+class CACHE_REPLACEMENT_STATE
+{
+public:
+    lruword *lru;   // each set's LRU stack, shared with the cache (see lru.h)
+    UINT8 *lruWide; // or with more than 16 ways, assoc positions per set
+  protected:
+
+    UINT32 numsets;
+    UINT32 assoc;
+
+    // how the cache splits an address (see SetGeometry)
+    UINT32 blockOffsetBits;
+    UINT32 setBits;
+    UINT32 setShift;
+
+    COUNTER mytimer;  // tracks # of references to the cache
+
+    // each set's role in its top two bits and its slot, its index among
+    // the sets of that role, in the rest; 0 for a follower
+    UINT16 *setRoles;
+
+    // how many sets each set AssignSetRoles gave a role stands for: 1,
+    // unless the cache was too small for as many as the policy asked
+    UINT32 roleWeight;
+
+    // the policy's own xorshift generator, so that every state draws the
+    // same numbers whatever thread runs it; see Random
+    UINT64 randState;
+
+  private:
+    vector<char *> arenaChunks;
+    char   *arenaNext;
+    size_t arenaLeft;
+    size_t arenaGrow; // the last chunk's least size, doubling up to 4MB
+
+  public:
+    // back the arenas of all replacement states made from now on with
+    // transparent huge pages
+    static bool hugePages;
+
+    // the scheme AssignSetRoles uses whatever a policy asks for, or -1
+    static int setSelect;
+    static const char *setSelectNames[SETS_SCHEMES];
+
+    // the replacement states made from now on are miniatures of caches
+    // with this many times their sets, so AssignSetRoles leaves at least
+    // half of their sets followers (see mrc.h)
+    static UINT32 miniature;
+
+    // only 1 in this many sets, the ones ChooseSampledSets picks, are
+    // simulated, so AssignSetRoles picks its sets among those, also
+    // leaving at least half of them followers
+    static UINT32 setSample;
+    static void ChooseSampledSets( UINT32 nsets, UINT32 n, UINT32 *sets );
+
+    CACHE_REPLACEMENT_STATE( UINT32 _sets, UINT32 _assoc );
+    virtual ~CACHE_REPLACEMENT_STATE(void);
+
+    // Called by the cache after making the replacement state, with its block
+    // size and set shift; until then the blocks are taken to be 64 bytes
+    void   SetGeometry( UINT32 blocksize, UINT32 _setShift );
+
+    // Starts Random over from seed; the sharded LLC gives each shard its own
+    void   SeedRandom( UINT64 seed );
+
+    // Called by the cache on a miss in a set with no invalid lines; returns
+    // the way to replace, or -1 to bypass
+    virtual INT32 GetVictimInSet( UINT32 tid, UINT32 setIndex, const LINE_STATE *vicSet, UINT32 assoc, Addr_t PC, Addr_t paddr, UINT32 accessType ) = 0;
+
+    // Called by the cache after every hit and fill
+    virtual void  UpdateReplacementState( UINT32 setIndex, INT32 updateWayID, const LINE_STATE *currLine,
+                                          UINT32 tid, Addr_t PC, UINT32 accessType, bool cacheHit ) = 0;
+
+    virtual ostream & PrintStats(ostream &out);
+
+    // Tables shared by all sets, for the sharded LLC to merge (see shard.cc).
+    // Fills in g, which has room for MAX_GLOBAL_COUNTERS, and returns how many.
+    virtual UINT32 GetGlobalCounters(GLOBAL_COUNTERS *g);
+
+    // Saves all of the policy's state to a checkpoint, or with restore reads
+    // it back into a policy constructed with the same parameters.  A policy
+    // that adds state saves it after calling this one.
+    virtual void   Checkpoint(FILE *f, bool restore);
+
+    void   IncrementTimer() { mytimer++; }
+
+  protected:
+    // the tag of paddr, the same one the cache gives its LINE_STATE
+    Addr_t Tag( Addr_t paddr ) { return numsets & (numsets - 1) ? (paddr >> blockOffsetBits) / numsets : (paddr >> blockOffsetBits) >> setBits; }
+
+    // n zeroed T's, aligned to a cache line, freed with the replacement state
+    template <class T> T *Carve( size_t n ) { return (T *) ArenaAlloc( n * sizeof(T) ); }
+    void   *ArenaAlloc( size_t bytes );
+
+    // choose n sets for each of nroles roles, 1 or 2, by scheme, once at
+    // startup; then SetRole and SetSlot cost a load instead of a division
+    void   AssignSetRoles( UINT32 n, UINT32 nroles, int scheme );
+    UINT32 SetRole( UINT32 setIndex ) { return setRoles[ setIndex ] >> 14; }
+
+    // the sampler sets to ask for where a full-sized cache would have n:
+    // a miniature keeps the same fraction of its sets, so that its shared
+    // tables train as often per fill, and at least one
+    UINT32 SamplerSets( UINT32 n ) { return max( n / miniature, 1u ); }
+    UINT32 SetSlot( UINT32 setIndex ) { return setRoles[ setIndex ] & 0x3fff; }
+
+    INT32  Get_Random_Victim( UINT32 setIndex );
+
+    // the next of the state's pseudo-random numbers, in place of rand (),
+    // whose one locked state the shards' threads would race for
+    UINT32 Random() {
+        randState ^= randState << 13;
+        randState ^= randState >> 7;
+        randState ^= randState << 17;
+        return (UINT32) (randState >> 32);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////
+    //                                                                        //
+    // Get_LRU_Victim finds the LRU victim in the cache set by returning the  //
+    // cache block at the bottom of the LRU stack. Top of LRU stack is '0'    //
+    // while bottom of LRU stack is 'assoc-1'.  UpdateLRU moves a way to the  //
+    // top.                                                                   //
+    //                                                                        //
+    ////////////////////////////////////////////////////////////////////////////
+    INT32  Get_LRU_Victim( UINT32 setIndex ) {
+        if( lruWide ) return lru_wide_victim( &lruWide[ setIndex * assoc ], assoc );
+        return lru_victim( lru[ setIndex ], assoc );
+    }
+    void   UpdateLRU( UINT32 setIndex, INT32 updateWayID ) {
+        if( lruWide ) lru_wide_touch( &lruWide[ setIndex * assoc ], assoc, updateWayID );
+        else lru[ setIndex ] = lru_touch( lru[ setIndex ], updateWayID );
+    }
+    UINT32 LRUPosition( UINT32 setIndex, INT32 way ) {
+        return lruWide ? lruWide[ setIndex * assoc + way ] : lru_position( lru[ setIndex ], way );
+    }
+};
+
+#endif
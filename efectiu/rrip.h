@@ -0,0 +1,85 @@
+// re-reference prediction values, one byte per way in a 16-byte vector for
+// every 16 ways of a set, for the RRIP policies and the ones built on them.
+// a way's RRPV is how far in the future it is expected to be referenced
+// again: 0 for soon, dist = 2^M-1 for the distant future.  bytes past assoc
+// hold 0 and are never aged.
+
+#ifndef __RRIP_H
+#define __RRIP_H
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#define RRIP_GROUP	16
+
+typedef struct {
+	unsigned char rrpv[RRIP_GROUP];
+} __attribute__ ((aligned (16))) rripset;
+
+// how many rripsets a set of assoc ways takes, and the RRPVs of set s of
+// an array of them
+
+static inline int rrip_groups (int assoc) {
+	return (assoc + RRIP_GROUP - 1) / RRIP_GROUP;
+}
+
+static inline unsigned char *rrip_rrpv (rripset *r, unsigned int s, int groups) {
+	return (unsigned char *) &r[s * groups];
+}
+
+// rrip_victim () for more than 16 ways, a byte at a time
+
+static inline int rrip_victim_wide (unsigned char *r, int assoc, unsigned int dist) {
+	unsigned int max = 0;
+	int first = 0;
+	for (int i=0; i<assoc; i++) {
+		if (r[i] == dist) return i;
+		if (r[i] > max) {
+			max = r[i];
+			first = i;
+		}
+	}
+	for (int i=0; i<assoc; i++) r[i] += dist - max;
+	return first;
+}
+
+// the way to replace: the first one at dist.  with none there, the set is
+// first aged until one is.  aging everything by one until some way gets to
+// dist is the same as adding dist minus the largest RRPV to every way in
+// one step, and the first way that was at the largest is the victim.
+
+static inline int rrip_victim (rripset *s, int assoc, unsigned int dist) {
+	unsigned int match;
+	if (assoc > RRIP_GROUP) return rrip_victim_wide ((unsigned char *) s, assoc, dist);
+#if defined(__SSE2__)
+	unsigned int ways = (1u << assoc) - 1;
+	__m128i v = _mm_load_si128 ((const __m128i *) s->rrpv);
+	match = _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (dist))) & ways;
+	if (match) return __builtin_ctz (match);
+
+	// the largest RRPV, folding the vector in half four times
+	__m128i m = _mm_max_epu8 (v, _mm_srli_si128 (v, 8));
+	m = _mm_max_epu8 (m, _mm_srli_si128 (m, 4));
+	m = _mm_max_epu8 (m, _mm_srli_si128 (m, 2));
+	m = _mm_max_epu8 (m, _mm_srli_si128 (m, 1));
+	unsigned int max = _mm_cvtsi128_si32 (m) & 0xff;
+	__m128i inset = _mm_cmplt_epi8 (_mm_setr_epi8 (0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15), _mm_set1_epi8 (assoc));
+	match = _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (max))) & ways;
+	_mm_store_si128 ((__m128i *) s->rrpv, _mm_add_epi8 (v, _mm_and_si128 (_mm_set1_epi8 (dist - max), inset)));
+#else
+	unsigned int max = 0;
+	match = 0;
+	for (int i=0; i<assoc; i++) {
+		if (s->rrpv[i] == dist) return i;
+		if (s->rrpv[i] > max) max = s->rrpv[i];
+	}
+	for (int i=0; i<assoc; i++) {
+		if (s->rrpv[i] == max) match |= 1u << i;
+		s->rrpv[i] += dist - max;
+	}
+#endif
+	return __builtin_ctz (match);
+}
+
+#endif
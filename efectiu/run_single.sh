@@ -0,0 +1 @@
+export DAN_POLICY=perceptron; ./efectiu ~/tracesWorking/400.perlbench-50B.trace.gz
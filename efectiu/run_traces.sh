@@ -0,0 +1,7 @@
+#!/bin/bash
+# Run every replacement policy over every trace in benchmarks.txt, as many
+# at a time as there are cores, and print each benchmark's IPCs and the
+# geometric mean speedup of each policy over LRU.  Each run's full output is
+# left in runs/.  runbench picks the packed or flat trace if trace2pack or
+# trace2flat has made one.
+./runbench -p lru,plru,random,bip,dip,srrip,drrip,ship,deadblock,perceptron -d ~/tracesWorking benchmarks.txt
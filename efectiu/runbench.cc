@@ -0,0 +1,325 @@
+// run efectiu over a list of benchmarks, for a set of policies under one or
+// more configurations, several simulations at a time, and report IPC, MPKI
+// and each policy's geometric mean speedup over the first one.
+//
+// every simulation gets one pass over its trace with DAN_POLICIES set to
+// all the policies.  the simulator keeps its state in globals, so each
+// simulation is a child process; a pool of threads each runs one child at
+// a time, taking the next job from a shared counter.  jobs are started
+// biggest trace first so that the last ones to finish are short.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+using namespace std;
+
+#define MAX_BENCHMARKS	1000
+#define MAX_CONFIGS	32
+#define MAX_POLICIES	16
+#define MAX_VARS	16
+
+extern char **environ;
+
+// a configuration is a name and some environment variables to run with,
+// given on the command line as name:VAR=value,VAR=value
+
+struct config {
+	char	*name;
+	char	*vars[MAX_VARS];
+	int	nvars;
+};
+
+struct job {
+	int	bench, conf;
+	char	trace[1100], out[1100];
+	off_t	size;
+	bool	ok;
+	double	ipc[MAX_POLICIES], mpki[MAX_POLICIES];
+	int	seconds;
+};
+
+char	*benchmarks[MAX_BENCHMARKS];
+int	nbenchmarks;
+config	configs[MAX_CONFIGS];
+int	nconfigs;
+char	policies[MAX_POLICIES][32];	// names, as in DAN_POLICIES
+int	npolicies;
+char	policy_list[200] = "lru,ship";
+const char *efectiu = "./efectiu", *tracedir = NULL, *outdir = "runs";
+
+job	*jobs;
+int	njobs, next_job, jobs_done;
+pthread_mutex_t print_lock = PTHREAD_MUTEX_INITIALIZER;
+
+// pick the packed or flat trace if trace2pack or trace2flat has made one
+
+void find_trace (job *j) {
+	static const char *suffixes[] = { "pack", "flat", "gz", NULL };
+	struct stat st;
+	for (int i=0; suffixes[i]; i++) {
+		sprintf (j->trace, "%s/%s.trace.%s", tracedir, benchmarks[j->bench], suffixes[i]);
+		if (stat (j->trace, &st) == 0) {
+			j->size = st.st_size;
+			return;
+		}
+	}
+	j->size = 0; // doesn't exist; efectiu will say so in the output file
+}
+
+// the environment for a child: ours, with the configuration's variables,
+// DAN_POLICIES and BENCHMARK_NAME replacing any we already have.  made
+// before forking since the child of a threaded process should only exec.
+
+char **make_env (job *j) {
+	config *c = &configs[j->conf];
+	int n = 0;
+	while (environ[n]) n++;
+	char **env = new char *[n + c->nvars + 3];
+	int m = 0;
+	for (int i=0; i<c->nvars; i++) env[m++] = c->vars[i];
+	env[m] = new char[strlen (policy_list) + 20];
+	sprintf (env[m++], "DAN_POLICIES=%s", policy_list);
+	env[m] = new char[strlen (benchmarks[j->bench]) + 20];
+	sprintf (env[m++], "BENCHMARK_NAME=%s", benchmarks[j->bench]);
+	int mine = m;
+	for (int i=0; i<n; i++) {
+		const char *eq = strchr (environ[i], '=');
+		int len = eq ? eq - environ[i] + 1 : strlen (environ[i]);
+		bool replaced = false;
+		for (int k=0; k<mine; k++) if (!strncmp (env[k], environ[i], len)) replaced = true;
+		if (!replaced) env[m++] = environ[i];
+	}
+	env[m] = NULL;
+	return env;
+}
+
+// get the last IPC and MPKI efectiu printed for each policy.  with one
+// policy the lines have no "policy name " label.
+
+bool parse_output (job *j) {
+	FILE *f = fopen (j->out, "r");
+	if (!f) return false;
+	bool got[MAX_POLICIES];
+	memset (got, 0, sizeof (got));
+	char line[1000];
+	while (fgets (line, sizeof (line), f)) {
+		char *s = line;
+		int p = 0;
+		if (npolicies > 1) {
+			char pol[32];
+			int len;
+			if (sscanf (s, "policy %31s %n", pol, &len) != 1) continue;
+			for (p=0; p<npolicies; p++) if (!strcmp (policies[p], pol)) break;
+			if (p == npolicies) continue;
+			s += len;
+		}
+		double v;
+		if (sscanf (s, "core 0: %lf IPC", &v) == 1 && strstr (s, "IPC")) {
+			j->ipc[p] = v;
+			got[p] = true;
+		} else if (sscanf (s, "L3 mpki: core 0: %lf", &v) == 1)
+			j->mpki[p] = v;
+	}
+	fclose (f);
+	for (int p=0; p<npolicies; p++) if (!got[p]) return false;
+	return true;
+}
+
+void run_job (job *j) {
+	char **env = make_env (j);
+	time_t start = time (NULL);
+	pid_t pid = fork ();
+	if (pid == 0) {
+		int fd = open (j->out, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (fd < 0) _exit (127);
+		dup2 (fd, 1);
+		dup2 (fd, 2);
+		close (fd);
+		execle (efectiu, efectiu, j->trace, (char *) NULL, env);
+		_exit (127);
+	}
+	int status = -1;
+	if (pid > 0) while (waitpid (pid, &status, 0) < 0 && errno == EINTR);
+	j->seconds = time (NULL) - start;
+	j->ok = pid > 0 && WIFEXITED (status) && WEXITSTATUS (status) == 0 && parse_output (j);
+	pthread_mutex_lock (&print_lock);
+	jobs_done++;
+	fprintf (stderr, "[%d/%d] %s %s %s in %d s\n", jobs_done, njobs, benchmarks[j->bench], configs[j->conf].name, j->ok ? "done" : "FAILED", j->seconds);
+	pthread_mutex_unlock (&print_lock);
+}
+
+void *worker (void *) {
+	for (;;) {
+		int i = __atomic_fetch_add (&next_job, 1, __ATOMIC_RELAXED);
+		if (i >= njobs) break;
+		run_job (&jobs[i]);
+	}
+	return NULL;
+}
+
+int bigger_first (const void *a, const void *b) {
+	off_t x = ((job *) a)->size, y = ((job *) b)->size;
+	return x < y ? 1 : x > y ? -1 : 0;
+}
+
+int in_order (const void *a, const void *b) {
+	const job *x = (job *) a, *y = (job *) b;
+	return x->conf != y->conf ? x->conf - y->conf : x->bench - y->bench;
+}
+
+void add_config (char *arg) {
+	if (nconfigs == MAX_CONFIGS) {
+		fprintf (stderr, "too many configurations\n");
+		exit (1);
+	}
+	config *c = &configs[nconfigs++];
+	char *colon = strchr (arg, ':');
+	char *vars = arg;
+	if (colon) {
+		*colon = 0;
+		c->name = arg;
+		vars = colon + 1;
+	} else
+		c->name = strdup (arg);
+	c->nvars = 0;
+	for (char *v = strtok (vars, ","); v; v = strtok (NULL, ",")) {
+		if (c->nvars == MAX_VARS || !strchr (v, '=')) {
+			fprintf (stderr, "bad configuration variable \"%s\"\n", v);
+			exit (1);
+		}
+		c->vars[c->nvars++] = v;
+	}
+}
+
+void usage (const char *me) {
+	fprintf (stderr, "usage: %s [-j jobs] [-p policies] [-c [name:]VAR=value,...]... [-d tracedir] [-o outdir] [-e efectiu] <benchmarks.txt>\n", me);
+	fprintf (stderr, "\t-j\tsimulations to run at once (default: number of cores)\n");
+	fprintf (stderr, "\t-p\tcomma-separated policy names; speedups are over the first (default lru,ship)\n");
+	fprintf (stderr, "\t-c\ta configuration to run every benchmark under; may be repeated\n");
+	fprintf (stderr, "\t-d\tdirectory holding the traces (default ~/tracesWorking)\n");
+	fprintf (stderr, "\t-o\tdirectory for each simulation's output (default runs)\n");
+	exit (1);
+}
+
+int main (int argc, char *argv[]) {
+	int nworkers = sysconf (_SC_NPROCESSORS_ONLN);
+	int opt;
+	while ((opt = getopt (argc, argv, "j:p:c:d:o:e:")) != -1) {
+		switch (opt) {
+			case 'j': nworkers = atoi (optarg); break;
+			case 'p': snprintf (policy_list, sizeof (policy_list), "%s", optarg); break;
+			case 'c': add_config (optarg); break;
+			case 'd': tracedir = optarg; break;
+			case 'o': outdir = optarg; break;
+			case 'e': efectiu = optarg; break;
+			default: usage (argv[0]);
+		}
+	}
+	if (optind != argc - 1 || nworkers < 1) usage (argv[0]);
+	if (!nconfigs) {
+		configs[0].name = (char *) "default";
+		configs[0].nvars = 0;
+		nconfigs = 1;
+	}
+	for (char *p = policy_list; *p; ) {
+		size_t n = strcspn (p, ", ");
+		if (!n) { p++; continue; } // skip separators
+		if (npolicies == MAX_POLICIES || n >= sizeof (policies[0])) usage (argv[0]);
+		memcpy (policies[npolicies], p, n);
+		policies[npolicies++][n] = 0;
+		p += n;
+	}
+	if (!npolicies) usage (argv[0]);
+	if (!tracedir) {
+		static char home[1000];
+		snprintf (home, sizeof (home), "%s/tracesWorking", getenv ("HOME") ? getenv ("HOME") : ".");
+		tracedir = home;
+	}
+
+	// read the benchmark names, one per line
+
+	FILE *f = fopen (argv[optind], "r");
+	if (!f) {
+		perror (argv[optind]);
+		return 1;
+	}
+	char line[1000];
+	while (fgets (line, sizeof (line), f)) {
+		line[strcspn (line, "\r\n")] = 0;
+		if (!line[0]) continue;
+		if (nbenchmarks == MAX_BENCHMARKS) {
+			fprintf (stderr, "too many benchmarks\n");
+			return 1;
+		}
+		benchmarks[nbenchmarks++] = strdup (line);
+	}
+	fclose (f);
+	if (mkdir (outdir, 0755) < 0 && errno != EEXIST) {
+		perror (outdir);
+		return 1;
+	}
+
+	njobs = nbenchmarks * nconfigs;
+	jobs = new job[njobs];
+	for (int c=0; c<nconfigs; c++) for (int b=0; b<nbenchmarks; b++) {
+		job *j = &jobs[c*nbenchmarks+b];
+		memset (j, 0, sizeof (job));
+		j->bench = b;
+		j->conf = c;
+		find_trace (j);
+		snprintf (j->out, sizeof (j->out), "%s/%s.%s.out", outdir, benchmarks[b], configs[c].name);
+	}
+	qsort (jobs, njobs, sizeof (job), bigger_first);
+	if (nworkers > njobs) nworkers = njobs;
+	pthread_t *threads = new pthread_t[nworkers];
+	for (int i=0; i<nworkers; i++) pthread_create (&threads[i], NULL, worker, NULL);
+	for (int i=0; i<nworkers; i++) pthread_join (threads[i], NULL);
+	qsort (jobs, njobs, sizeof (job), in_order);
+
+	// one line per benchmark, configuration and policy
+
+	printf ("benchmark\tconfig\tpolicy\tipc\tmpki\n");
+	for (int i=0; i<njobs; i++) {
+		job *j = &jobs[i];
+		for (int p=0; p<npolicies; p++) {
+			if (j->ok)
+				printf ("%s\t%s\t%s\t%0.4f\t%0.4f\n", benchmarks[j->bench], configs[j->conf].name, policies[p], j->ipc[p], j->mpki[p]);
+			else
+				printf ("%s\t%s\t%s\t-\t-\n", benchmarks[j->bench], configs[j->conf].name, policies[p]);
+		}
+	}
+
+	// geometric mean speedup of each policy over the first, per
+	// configuration, over the benchmarks that ran
+
+	printf ("\n");
+	int failed = 0;
+	for (int c=0; c<nconfigs; c++) {
+		for (int p=1; p<npolicies; p++) {
+			double sum = 0.0;
+			int n = 0;
+			for (int i=0; i<njobs; i++) {
+				job *j = &jobs[i];
+				if (j->conf != c || !j->ok) continue;
+				sum += log (j->ipc[p] / j->ipc[0]);
+				n++;
+			}
+			printf ("gmean speedup %s policy %s over policy %s: ", configs[c].name, policies[p], policies[0]);
+			if (n) printf ("%0.4f (%d benchmarks)\n", exp (sum / n), n); else printf ("- (no benchmarks)\n");
+		}
+	}
+	for (int i=0; i<njobs; i++) if (!jobs[i].ok) {
+		fprintf (stderr, "failed: %s %s; see %s\n", benchmarks[jobs[i].bench], configs[jobs[i].conf].name, jobs[i].out);
+		failed++;
+	}
+	return failed ? 1 : 0;
+}
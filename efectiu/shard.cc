@@ -0,0 +1,145 @@
+// set-sharded parallel LLC simulation; see shard.h
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <sched.h>
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "shard.h"
+
+unsigned int memory_access (cache **l1, cache **l2, cache *l3, unsigned long long int address, unsigned long long int, unsigned int, int op, unsigned int);
+
+static void *shard_worker (void *arg) {
+	shard *h = (shard *) arg;
+	shardset *s = h->set;
+	unsigned long long int head = h->head;
+	for (;;) {
+		unsigned long long int tail = __atomic_load_n (&h->tail, __ATOMIC_ACQUIRE);
+		if (head == tail) {
+			if (__atomic_load_n (&s->stopping, __ATOMIC_ACQUIRE)) break;
+			sched_yield ();
+			continue;
+		}
+		for (; head != tail; head++) {
+			shardaccess *a = &h->queue[head & (SHARD_QUEUE-1)];
+			for (int p=0; p<s->npolicies; p++) {
+				unsigned int miss = memory_access (NULL, NULL, &h->llc[p], a->address, a->pc, a->size, a->op, a->core);
+				if (miss & 4) h->misses[p*s->max_cores+a->core]++;
+			}
+			__atomic_store_n (&h->head, head+1, __ATOMIC_RELEASE);
+		}
+	}
+	return NULL;
+}
+
+void init_shards (shardset *s, cache *llc, int npolicies, int max_cores, int nshards, int sync) {
+	assert (nshards >= 1 && nshards <= MAX_SHARDS);
+	s->nshards = nshards;
+	s->npolicies = npolicies;
+	s->max_cores = max_cores;
+	s->sync = sync;
+	s->since_sync = 0;
+	s->stopping = false;
+	s->llc = llc;
+	s->shards = new shard[nshards];
+	for (int i=0; i<nshards; i++) {
+		shard *h = &s->shards[i];
+		h->queue = new shardaccess[SHARD_QUEUE];
+		h->head = h->tail = h->seen_head = 0;
+		h->set = s;
+		h->llc = new cache[npolicies];
+		for (int p=0; p<npolicies; p++) {
+			h->llc[p] = llc[p];
+			h->llc[p].repl = llc[p].policy->make (llc[p].nsets, llc[p].assoc);
+			h->llc[p].repl->SetGeometry (llc[p].blocksize, llc[p].set_shift);
+			h->llc[p].repl->SeedRandom (i + 1);
+		}
+		h->misses = new unsigned long long int[npolicies*max_cores];
+		memset (h->misses, 0, npolicies * max_cores * sizeof (unsigned long long int));
+		int r = pthread_create (&h->thread, NULL, shard_worker, h);
+		assert (r == 0);
+	}
+}
+
+// fold what each shard learned since the last barrier into the main LLC's
+// tables and start every shard over from the result.  counters that
+// several shards moved the same way add up, then saturate as they would
+// have in one table.
+
+static inline INT64 get_counter (GLOBAL_COUNTERS *g, UINT32 k) {
+	return g->s ? g->s[k] : g->u ? g->u[k] : g->s8[k];
+}
+
+static inline void set_counter (GLOBAL_COUNTERS *g, UINT32 k, INT64 v) {
+	if (g->s) g->s[k] = v; else if (g->u) g->u[k] = v; else g->s8[k] = v;
+}
+
+static void merge_shards (shardset *s) {
+	GLOBAL_COUNTERS base[MAX_GLOBAL_COUNTERS], mine[MAX_SHARDS][MAX_GLOBAL_COUNTERS];
+	for (int p=0; p<s->npolicies; p++) {
+		UINT32 ntables = s->llc[p].repl->GetGlobalCounters (base);
+		for (int i=0; i<s->nshards; i++) s->shards[i].llc[p].repl->GetGlobalCounters (mine[i]);
+		for (UINT32 t=0; t<ntables; t++) {
+			GLOBAL_COUNTERS *b = &base[t];
+			for (UINT32 k=0; k<b->n; k++) {
+				INT64 old = get_counter (b, k), v = old;
+				for (int i=0; i<s->nshards; i++) v += get_counter (&mine[i][t], k) - old;
+				if (v < b->lo) v = b->lo;
+				if (v > b->hi) v = b->hi;
+				set_counter (b, k, v);
+				for (int i=0; i<s->nshards; i++) set_counter (&mine[i][t], k, v);
+			}
+		}
+	}
+}
+
+void shard_access (shardset *s, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core) {
+	cache *c = &s->llc[0];
+	unsigned int set = cache_set (c, address);
+	shard *h = &s->shards[set % s->nshards];
+	unsigned long long int tail = h->tail;
+	while (tail - h->seen_head == SHARD_QUEUE) {
+		h->seen_head = __atomic_load_n (&h->head, __ATOMIC_ACQUIRE);
+		if (tail - h->seen_head == SHARD_QUEUE) sched_yield ();
+	}
+	shardaccess *a = &h->queue[tail & (SHARD_QUEUE-1)];
+	a->address = address;
+	a->pc = pc;
+	a->size = size;
+	a->op = op;
+	a->core = core;
+	__atomic_store_n (&h->tail, tail+1, __ATOMIC_RELEASE);
+	if (s->sync && ++s->since_sync == s->sync) {
+		shard_drain (s);
+		merge_shards (s);
+		s->since_sync = 0;
+	}
+}
+
+// wait until every shard has simulated everything queued for it
+
+void shard_drain (shardset *s) {
+	for (int i=0; i<s->nshards; i++) {
+		shard *h = &s->shards[i];
+		while (__atomic_load_n (&h->head, __ATOMIC_ACQUIRE) != h->tail) sched_yield ();
+	}
+}
+
+// add up the shards' miss counts into misses[p][core], max_cores to a row.
+// the shards must be drained first.
+
+void shard_misses (shardset *s, unsigned long long int *misses) {
+	for (int p=0; p<s->npolicies; p++) for (int c=0; c<s->max_cores; c++) {
+		unsigned long long int sum = 0;
+		for (int i=0; i<s->nshards; i++) sum += s->shards[i].misses[p*s->max_cores+c];
+		misses[p*s->max_cores+c] = sum;
+	}
+}
+
+void close_shards (shardset *s) {
+	shard_drain (s);
+	__atomic_store_n (&s->stopping, true, __ATOMIC_RELEASE);
+	for (int i=0; i<s->nshards; i++) pthread_join (s->shards[i].thread, NULL);
+}
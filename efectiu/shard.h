@@ -0,0 +1,62 @@
+// set-sharded parallel LLC simulation
+
+#ifndef __SHARD_H
+#define __SHARD_H
+
+#include <pthread.h>
+
+#define MAX_SHARDS	64
+#define SHARD_QUEUE	(1<<14)	// accesses buffered per shard; a power of 2
+
+struct shardaccess {
+	unsigned long long int address, pc;
+	unsigned int size;
+	unsigned char op, core;
+};
+
+// shard i simulates the LLC sets whose index is i mod nshards, for every
+// policy, on its own thread.  the sets themselves are shared with the
+// main LLCs since no two shards touch the same set, but each shard gets
+// its own replacement state so tables shared by all sets (SHCT, PSEL,
+// perceptron weights) are never written by two threads.  accesses come
+// through a ring that only the main thread writes and only the worker
+// reads.
+
+struct shard {
+	shardaccess *queue;
+
+	// head is written by the worker and tail by the main thread, so they
+	// sit on different cache lines.  seen_head is the main thread's last
+	// look at head, which it only needs to refresh when the ring looks full.
+
+	unsigned long long int head;
+	char	pad0[64];
+	unsigned long long int tail, seen_head;
+	cache	*llc;				// one per policy
+	unsigned long long int *misses;		// misses[p*max_cores+core]
+	struct shardset *set;
+	pthread_t thread;
+	char	pad1[64];
+};
+
+// with sync == 0 each shard learns its global tables only from its own
+// sets.  otherwise every sync accesses the main thread waits for the
+// shards to empty their queues and folds the changes each shard made to
+// its tables since the last barrier into one copy that every shard then
+// continues from.
+
+struct shardset {
+	int	nshards, npolicies, max_cores, sync;
+	long long int since_sync;
+	bool	stopping;
+	cache	*llc;				// the main LLCs, which hold the merged tables
+	shard	*shards;
+};
+
+void init_shards (shardset *s, cache *llc, int npolicies, int max_cores, int nshards, int sync);
+void shard_access (shardset *s, unsigned long long int address, unsigned long long int pc, unsigned int size, int op, unsigned int core);
+void shard_drain (shardset *s);
+void shard_misses (shardset *s, unsigned long long int *misses);
+void close_shards (shardset *s);
+
+#endif
@@ -0,0 +1,89 @@
+// one-pass LRU miss counts for every cache geometry; see stackdist.h
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "stackdist.h"
+
+#define EMPTY	(~0ull)
+
+int lg2 (int n);
+
+#define HIST(s,h,core,l,d)	((h)[((core) * (s)->levels + (l)) * (STACKDIST_ASSOC+1) + (d)])
+
+void init_stackdist (stackdist *s, int max_sets, int blocksize, int set_shift, int ncores) {
+	s->levels = lg2 (max_sets) + 1;
+	s->offset_bits = lg2 (blocksize);
+	s->set_shift = set_shift;
+	s->ncores = ncores;
+	s->stacks = new unsigned long long int *[s->levels];
+	for (int l=0; l<s->levels; l++) {
+		long long int n = (1ll << l) * STACKDIST_ASSOC;
+		s->stacks[l] = new unsigned long long int[n];
+		for (long long int i=0; i<n; i++) s->stacks[l][i] = EMPTY;
+	}
+	int nhist = ncores * s->levels * (STACKDIST_ASSOC+1);
+	s->hist = new unsigned long long int[nhist];
+	s->hist_at_warming = new unsigned long long int[nhist];
+	memset (s->hist, 0, nhist * sizeof (unsigned long long int));
+	memset (s->hist_at_warming, 0, nhist * sizeof (unsigned long long int));
+}
+
+// every access moves its block to the top of its stack at every level, as
+// the LRU cache does, but only the accesses cache_access counts as misses
+// are counted
+
+void stackdist_access (stackdist *s, unsigned long long int address, int op, unsigned int core) {
+	unsigned long long int block_addr = address >> s->offset_bits;
+	unsigned long long int set_bits = block_addr >> s->set_shift;
+	bool counted = op != DAN_WRITEBACK && op != DAN_PREFETCH;
+	for (int l=0; l<s->levels; l++) {
+		unsigned long long int *v = s->stacks[l] + (set_bits & ((1ull << l) - 1)) * STACKDIST_ASSOC;
+		int d;
+		for (d=0; d<STACKDIST_ASSOC; d++) if (v[d] == block_addr) break;
+		if (counted) HIST (s, s->hist, core, l, d)++;
+		if (d == STACKDIST_ASSOC) d = STACKDIST_ASSOC - 1; // falls off the bottom
+		memmove (v + 1, v, d * sizeof (unsigned long long int));
+		v[0] = block_addr;
+	}
+}
+
+void stackdist_warmed (stackdist *s) {
+	memcpy (s->hist_at_warming, s->hist, s->ncores * s->levels * (STACKDIST_ASSOC+1) * sizeof (unsigned long long int));
+}
+
+void checkpoint_stackdist (FILE *f, stackdist *s, bool restore) {
+	for (int l=0; l<s->levels; l++) CheckpointIO (f, restore, s->stacks[l], (1ll << l) * STACKDIST_ASSOC * sizeof (unsigned long long int));
+	int nhist = s->ncores * s->levels * (STACKDIST_ASSOC+1);
+	CheckpointIO (f, restore, s->hist, nhist * sizeof (unsigned long long int));
+	CheckpointIO (f, restore, s->hist_at_warming, nhist * sizeof (unsigned long long int));
+}
+
+// print an MPKI table for each core: one row per number of sets, one
+// column per associativity
+
+void print_stackdist (stackdist *s, unsigned long long int *insts) {
+	for (int core=0; core<s->ncores; core++) {
+		printf ("LRU mpki by sets (rows) and assoc (columns) for core %d:\n%8s", core, "sets");
+		for (int a=1; a<=STACKDIST_ASSOC; a++) printf (" %8d", a);
+		printf ("\n");
+		for (int l=0; l<s->levels; l++) {
+			printf ("%8d", 1 << l);
+
+			// misses with assoc a are the accesses at distance a or more
+
+			unsigned long long int misses = 0;
+			unsigned long long int m[STACKDIST_ASSOC+1];
+			for (int d=STACKDIST_ASSOC; d>=1; d--) {
+				misses += HIST (s, s->hist, core, l, d) - HIST (s, s->hist_at_warming, core, l, d);
+				m[d] = misses;
+			}
+			for (int a=1; a<=STACKDIST_ASSOC; a++) printf (" %8.3f", 1000.0 * m[a] / (double) insts[core]);
+			printf ("\n");
+		}
+	}
+	fflush (stdout);
+}
@@ -0,0 +1,31 @@
+// LRU stack distance profiler
+
+#ifndef __STACKDIST_H
+#define __STACKDIST_H
+
+// for each power-of-two number of sets up to max_sets, keep the top
+// STACKDIST_ASSOC entries of every set's LRU stack.  the position an access is
+// found at is its stack distance in that set, and by the inclusion property
+// of LRU an access hits in an A-way cache with that many sets exactly when
+// its distance is less than A.  so one pass gives the LRU miss count of
+// every (sets, assoc <= STACKDIST_ASSOC) geometry.
+
+#define STACKDIST_ASSOC	16
+
+struct stackdist {
+	int	levels, offset_bits, set_shift, ncores;
+	unsigned long long int **stacks;	// stacks[l] holds (1<<l) sets of STACKDIST_ASSOC block addresses, MRU first
+
+	// hist[core][l][d] counts accesses at distance d with 1<<l sets;
+	// d == STACKDIST_ASSOC means not in the top STACKDIST_ASSOC, including cold misses
+
+	unsigned long long int *hist, *hist_at_warming;
+};
+
+void init_stackdist (stackdist *s, int max_sets, int blocksize, int set_shift, int ncores);
+void stackdist_access (stackdist *s, unsigned long long int address, int op, unsigned int core);
+void stackdist_warmed (stackdist *s);
+void checkpoint_stackdist (FILE *f, stackdist *s, bool restore);
+void print_stackdist (stackdist *s, unsigned long long int *insts);
+
+#endif
@@ -0,0 +1,759 @@
+// trace reader
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <zlib.h>
+#include <pthread.h>
+#include <map>
+#include <vector>
+
+using namespace std;
+
+struct trace {
+        int cmd;
+        unsigned int size;
+        unsigned long long int pc;
+        unsigned long long int address;
+        unsigned long long int instr;
+        unsigned long long int cycle;
+};
+
+// header of a flat trace written by trace2flat.  the records follow at
+// the next page boundary, stored exactly as they are in the .gz trace.
+
+#define FLAT_TRACE_MAGIC	"efctflat"
+#define FLAT_TRACE_VERSION	1
+#define FLAT_TRACE_ALIGN	4096
+
+struct flatheader {
+	char magic[8];
+	unsigned int version;
+	unsigned int record_size;
+	unsigned long long int nrecords;
+};
+
+// compact trace written by trace2pack.  records are grouped into blocks
+// and each block stores each field as its own column of varints:
+//
+//	cmd	one byte per record
+//	size	the access size
+//	pc	index into a PC dictionary that grows as new PCs appear; an
+//		index equal to the dictionary size means the next 8-byte PC
+//		in the newpc column is added to the dictionary
+//	address	zigzagged difference from the previous address
+//	instr	zigzagged difference from the previous instruction count
+//	cycle	zigzagged difference of (cycle - instr) from the previous record
+//
+// the differences start over from 0 at each block; the dictionary does not.
+// the file is the header followed by the blocks, each a packblock header
+// followed by its columns in the order above.
+
+#define PACK_TRACE_MAGIC	"efctpack"
+#define PACK_TRACE_VERSION	1
+#define PACK_BLOCK_RECORDS	(1<<16)
+
+enum {
+	PACK_CMD, PACK_SIZE, PACK_PC, PACK_NEWPC, PACK_ADDRESS, PACK_INSTR, PACK_CYCLE,
+	PACK_NCOLUMNS
+};
+
+struct packheader {
+	char magic[8];
+	unsigned int version;
+	unsigned int block_records;
+	unsigned long long int nrecords;
+	unsigned long long int nblocks;
+};
+
+struct packblock {
+	unsigned int nrecords;
+	unsigned int column_bytes[PACK_NCOLUMNS];
+};
+
+static inline unsigned long long int zigzag (long long int v) {
+	return ((unsigned long long int) v << 1) ^ (unsigned long long int) (v >> 63);
+}
+
+static inline long long int unzigzag (unsigned long long int v) {
+	return (long long int) (v >> 1) ^ -(long long int) (v & 1);
+}
+
+static inline unsigned char *put_varint (unsigned char *p, unsigned long long int v) {
+	while (v >= 0x80) {
+		*p++ = v | 0x80;
+		v >>= 7;
+	}
+	*p++ = v;
+	return p;
+}
+
+static inline unsigned long long int get_varint (const unsigned char *&p) {
+	unsigned long long int v = *p++;
+	if (v < 0x80) return v;
+	v &= 0x7f;
+	for (int shift=7;; shift+=7) {
+		unsigned long long int b = *p++;
+		v |= (b & 0x7f) << shift;
+		if (b < 0x80) return v;
+	}
+}
+
+// index of access points into a .gz trace written by traceindex as
+// <trace>.idx.  each point is a deflate block boundary where inflation can
+// resume given the 32KB of output that preceded it; instr is the
+// instruction count of the first whole record after the point.  the
+// header is followed by npoints indexpoints, each followed by its window.
+
+#define INDEX_TRACE_MAGIC	"efctidx\0"
+#define INDEX_TRACE_VERSION	1
+#define INDEX_WINDOW		32768
+
+struct indexheader {
+	char magic[8];
+	unsigned int version;
+	unsigned int npoints;
+	unsigned long long int span;	// instructions between points
+};
+
+struct indexpoint {
+	unsigned long long int in;	// offset in the compressed file
+	unsigned long long int out;	// offset in the uncompressed trace
+	unsigned long long int instr;
+	unsigned int bits;		// bits of the byte before in that belong to the point
+	unsigned int pad;
+};
+
+// raw inflate of a .gz trace starting from an index point
+
+struct seekstream {
+	FILE *fp;
+	z_stream strm;
+	unsigned char in[1<<16];
+	bool done;
+};
+
+// a buffer of already-inflated trace records filled by the inflate thread
+
+struct tracechunk {
+	trace *records;
+	unsigned int n;		// number of valid records; fewer than a full chunk means end of file
+};
+
+// a tracereader's position in its trace, for checkpoints
+
+struct readerstate {
+	trace	t;
+	unsigned long long int icount, current_cycle, current_instr, cyclecount;
+	unsigned long long int insts_upto_restart, cycles_upto_restart, instr_records, lap;
+	long long restart_cycles;
+};
+
+class tracereader {
+	gzFile tracefp;
+	trace t;
+	unsigned long long int icount, current_cycle, current_instr, cyclecount;
+	unsigned long long int insts_upto_restart, cycles_upto_restart;
+	char filename[1000];
+	long long restart_cycles;
+
+	// how many records in a row read () has returned with instruction
+	// current_instr, which with it says where in the file the reader is
+	// for a checkpoint
+
+	unsigned long long int instr_records;
+
+	// how many instructions one pass of the trace is, after which it
+	// repeats; 0 until it first restarts
+
+	unsigned long long int lap;
+
+	// set by seek () to inflate from an index point instead of tracefp
+	// until the trace next restarts
+
+	seekstream *zs;
+
+	// seek () leaves the first record to simulate in t for read ()
+
+	bool held;
+
+	// background inflate state; nchunks == 0 means records are read
+	// with gzread on the calling thread
+
+	pthread_t inflater;
+	pthread_mutex_t lock;
+	pthread_cond_t filled, drained;
+	tracechunk *chunks;
+	int nchunks, head, tail, count;
+	unsigned int chunk_records, pos;
+	unsigned int generation;
+	bool rewind_pending, stopping;
+
+	// mmapped flat or packed trace; map == NULL means a gzipped trace
+
+	void *map;
+	size_t map_bytes;
+	bool packed;
+	trace *flat_records;
+	unsigned long long int flat_n, flat_pos;
+	const unsigned char *pack_first, *pack_next, *pack_col[PACK_NCOLUMNS];
+	unsigned long long int pack_nblocks, pack_block;
+	unsigned int pack_left;
+	unsigned long long int pack_address, pack_instr, pack_skew;
+	vector<unsigned long long int> pack_dict;
+
+	// map name if it is a flat or packed trace, returning false if it
+	// is neither
+
+	bool open_mapped (const char *name) {
+		int fd = ::open (name, O_RDONLY);
+		if (fd < 0) return false;
+		char magic[8];
+		if (pread (fd, magic, sizeof (magic), 0) != sizeof (magic) 
+			|| (memcmp (magic, FLAT_TRACE_MAGIC, sizeof (magic)) && memcmp (magic, PACK_TRACE_MAGIC, sizeof (magic)))) {
+			::close (fd);
+			return false;
+		}
+		struct stat st;
+		fstat (fd, &st);
+		map_bytes = st.st_size;
+		map = mmap (NULL, map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+		::close (fd);
+		if (map == MAP_FAILED) {
+			perror (name);
+			assert (0);
+		}
+		madvise (map, map_bytes, MADV_SEQUENTIAL);
+		packed = !memcmp (magic, PACK_TRACE_MAGIC, sizeof (magic));
+		if (packed) {
+			packheader h;
+			if (map_bytes >= sizeof (h)) memcpy (&h, map, sizeof (h));
+			if (map_bytes < sizeof (h) || h.version != PACK_TRACE_VERSION) {
+				fprintf (stderr, "%s: bad packed trace; regenerate it with trace2pack\n", name);
+				assert (0);
+			}
+			pack_first = (const unsigned char *) map + sizeof (h);
+			pack_nblocks = h.nblocks;
+			pack_rewind ();
+		} else {
+			flatheader h;
+			if (map_bytes >= sizeof (h)) memcpy (&h, map, sizeof (h));
+			if (map_bytes < FLAT_TRACE_ALIGN || h.version != FLAT_TRACE_VERSION || h.record_size != sizeof (trace) 
+				|| map_bytes < FLAT_TRACE_ALIGN + h.nrecords * sizeof (trace)) {
+				fprintf (stderr, "%s: bad or truncated flat trace; regenerate it with trace2flat\n", name);
+				assert (0);
+			}
+			flat_records = (trace *) ((char *) map + FLAT_TRACE_ALIGN);
+			flat_n = h.nrecords;
+			flat_pos = 0;
+		}
+		return true;
+	}
+
+	unsigned int flat_read (void) {
+		if (flat_pos == flat_n) return 0;
+		t = flat_records[flat_pos++];
+		return 1;
+	}
+
+	void pack_rewind (void) {
+		pack_next = pack_first;
+		pack_block = 0;
+		pack_left = 0;
+		pack_dict.clear ();
+	}
+
+	// decode the next record of a packed trace into t, one value from
+	// each column
+
+	unsigned int pack_read (void) {
+		while (!pack_left) {
+			if (pack_block == pack_nblocks) return 0;
+			packblock b;
+			memcpy (&b, pack_next, sizeof (b));
+			const unsigned char *p = pack_next + sizeof (b);
+			for (int i=0; i<PACK_NCOLUMNS; i++) {
+				pack_col[i] = p;
+				p += b.column_bytes[i];
+			}
+			assert (p <= (const unsigned char *) map + map_bytes);
+			pack_next = p;
+			pack_block++;
+			pack_left = b.nrecords;
+			pack_address = 0;
+			pack_instr = 0;
+			pack_skew = 0;
+		}
+		pack_left--;
+		t.cmd = *pack_col[PACK_CMD]++;
+		t.size = get_varint (pack_col[PACK_SIZE]);
+		unsigned long long int i = get_varint (pack_col[PACK_PC]);
+		if (i == pack_dict.size ()) {
+			unsigned long long int pc;
+			memcpy (&pc, pack_col[PACK_NEWPC], sizeof (pc));
+			pack_col[PACK_NEWPC] += sizeof (pc);
+			pack_dict.push_back (pc);
+		}
+		t.pc = pack_dict[i];
+		pack_address += unzigzag (get_varint (pack_col[PACK_ADDRESS]));
+		pack_instr += unzigzag (get_varint (pack_col[PACK_INSTR]));
+		pack_skew += unzigzag (get_varint (pack_col[PACK_CYCLE]));
+		t.address = pack_address;
+		t.instr = pack_instr;
+		t.cycle = pack_instr + pack_skew;
+		return 1;
+	}
+
+	// fill chunks with inflated records until told to stop.  runs on
+	// its own thread; this is the only place tracefp is touched once
+	// the thread is started.
+
+	static void *inflate_thread (void *arg) {
+		tracereader *r = (tracereader *) arg;
+		pthread_mutex_lock (&r->lock);
+		for (;;) {
+			while (r->count == r->nchunks && !r->stopping) 
+				pthread_cond_wait (&r->drained, &r->lock);
+			if (r->stopping) break;
+			if (r->rewind_pending) {
+				r->raw_rewind ();
+				r->rewind_pending = false;
+			}
+			unsigned int gen = r->generation;
+			tracechunk *c = &r->chunks[r->tail];
+			pthread_mutex_unlock (&r->lock);
+
+			// inflate without holding the lock so the simulation
+			// thread can keep consuming earlier chunks
+
+			int bytes = r->raw_read (c->records, r->chunk_records * sizeof (trace));
+			if (bytes < 0) bytes = 0;
+			c->n = bytes / sizeof (trace);
+			if (c->n < r->chunk_records) r->raw_rewind ();
+
+			pthread_mutex_lock (&r->lock);
+
+			// the reader restarted the trace while we were
+			// inflating; this chunk is stale
+
+			if (gen != r->generation) continue;
+			r->tail = (r->tail + 1) % r->nchunks;
+			r->count++;
+			pthread_cond_signal (&r->filled);
+		}
+		pthread_mutex_unlock (&r->lock);
+		return NULL;
+	}
+
+	// copy the next record from the inflated chunks into t.  returns
+	// 0 at the end of the trace file, just like gzfread.
+
+	unsigned int chunk_read (void) {
+		tracechunk *c = &chunks[head];
+		if (pos == chunk_records) {
+			pthread_mutex_lock (&lock);
+			head = (head + 1) % nchunks;
+			count--;
+			pos = 0;
+			pthread_cond_signal (&drained);
+			pthread_mutex_unlock (&lock);
+			c = &chunks[head];
+		}
+		if (pos == 0) {
+			pthread_mutex_lock (&lock);
+			while (count == 0) pthread_cond_wait (&filled, &lock);
+			pthread_mutex_unlock (&lock);
+		}
+		if (pos == c->n) {
+
+			// hit the end of the file.  give this chunk back; the
+			// inflate thread has already rewound for the next pass.
+
+			pthread_mutex_lock (&lock);
+			head = (head + 1) % nchunks;
+			count--;
+			pos = 0;
+			pthread_cond_signal (&drained);
+			pthread_mutex_unlock (&lock);
+			return 0;
+		}
+		t = c->records[pos++];
+		return 1;
+	}
+
+public:
+
+	unsigned long long int get_icount (void) { return icount; }
+	unsigned long long int get_cycles (void) { return cyclecount; }
+	unsigned long long int get_lap (void) { return lap; }
+
+	// open a trace file, either gzipped, flat or packed
+
+	void open (const char *name) {
+		tracefp = NULL;
+		if (open_mapped (name)) return;
+		tracefp = gzopen (name, "r");
+		if (!tracefp) {
+			char hostname[1000];
+			gethostname (hostname, 1000);
+			fprintf (stderr, "%s: ", hostname);
+			perror (name);
+			fflush (stderr);
+		}
+		assert (tracefp);
+	}
+
+	// read bytes of the uncompressed .gz trace from wherever it is positioned
+
+	int raw_read (void *buf, int bytes) {
+		if (!zs) return gzread (tracefp, buf, bytes);
+		z_stream *s = &zs->strm;
+		s->next_out = (Bytef *) buf;
+		s->avail_out = bytes;
+		while (s->avail_out && !zs->done) {
+			if (!s->avail_in) {
+				s->avail_in = fread (zs->in, 1, sizeof (zs->in), zs->fp);
+				s->next_in = zs->in;
+				if (!s->avail_in) break;
+			}
+			int e = inflate (s, Z_NO_FLUSH);
+			if (e == Z_STREAM_END) 
+				zs->done = true;
+			else if (e != Z_OK) {
+				fprintf (stderr, "%s: inflate error %d after seek\n", filename, e);
+				assert (0);
+			}
+		}
+		return bytes - s->avail_out;
+	}
+
+	void seek_close (void) {
+		if (!zs) return;
+		inflateEnd (&zs->strm);
+		fclose (zs->fp);
+		delete zs;
+		zs = NULL;
+	}
+
+	void raw_rewind (void) {
+		seek_close ();
+		gzrewind (tracefp);
+	}
+
+	// position the .gz trace at the last index point before instruction
+	// instr, if there is an index.  returns false if there is not.
+
+	bool seek_index (unsigned long long int instr) {
+		char name[1010];
+		sprintf (name, "%s.idx", filename);
+		FILE *f = fopen (name, "r");
+		if (!f) return false;
+		indexheader h;
+		if (fread (&h, sizeof (h), 1, f) != 1 || memcmp (h.magic, INDEX_TRACE_MAGIC, sizeof (h.magic)) 
+			|| h.version != INDEX_TRACE_VERSION) {
+			fprintf (stderr, "%s: not a trace index; regenerate it with traceindex\n", name);
+			fclose (f);
+			return false;
+		}
+		indexpoint p, best;
+		long best_window = -1;
+		static unsigned char window[INDEX_WINDOW];
+		for (unsigned int i=0; i<h.npoints; i++) {
+			if (fread (&p, sizeof (p), 1, f) != 1) break;
+			if (p.instr > instr) break;
+			best = p;
+			best_window = ftell (f);
+			fseek (f, INDEX_WINDOW, SEEK_CUR);
+		}
+		bool found = best_window >= 0;
+		if (found) {
+			fseek (f, best_window, SEEK_SET);
+			if (fread (window, 1, INDEX_WINDOW, f) != INDEX_WINDOW) found = false;
+		}
+		fclose (f);
+		if (!found) return false;
+
+		zs = new seekstream;
+		memset (&zs->strm, 0, sizeof (zs->strm));
+		zs->done = false;
+		zs->fp = fopen (filename, "r");
+		assert (zs->fp);
+		int e = inflateInit2 (&zs->strm, -15); // raw deflate, no gzip header
+		assert (e == Z_OK);
+		fseek (zs->fp, best.in - (best.bits ? 1 : 0), SEEK_SET);
+		if (best.bits) {
+			int c = getc (zs->fp);
+			inflatePrime (&zs->strm, best.bits, c >> (8 - best.bits));
+		}
+		inflateSetDictionary (&zs->strm, window, INDEX_WINDOW);
+
+		// the point can fall in the middle of a record; skip to the next one
+
+		unsigned int partial = (sizeof (trace) - best.out % sizeof (trace)) % sizeof (trace);
+		trace scratch;
+		if (partial) raw_read (&scratch, partial);
+		printf ("seeking \"%s\" from index point at instruction %lld\n", filename, best.instr);
+		fflush (stdout);
+		return true;
+	}
+
+	// get the next record of the trace file into t as it is stored.
+	// returns 0 at the end of the file.
+
+	unsigned int next (void) {
+		if (map) return packed ? pack_read () : flat_read ();
+		if (nchunks) return chunk_read ();
+		return raw_read (&t, sizeof (t)) / sizeof (t);
+	}
+
+	const char *getname (void) {
+		return filename;
+	}
+
+	// the record the last read () returned
+
+	trace *current (void) {
+		return &t;
+	}
+
+	// save where the reader is and the last record it returned, or with
+	// restore go back there in a reader just opened on the same trace.
+	// the file is found again by seeking to the instruction of that
+	// record and then past as many records with that instruction as had
+	// been read.  like seek (), restoring must come before background ().
+
+	void checkpoint (FILE *f, bool restore) {
+		readerstate r;
+		if (!restore) {
+			r.t = t;
+			r.icount = icount;
+			r.current_cycle = current_cycle;
+			r.current_instr = current_instr;
+			r.cyclecount = cyclecount;
+			r.insts_upto_restart = insts_upto_restart;
+			r.cycles_upto_restart = cycles_upto_restart;
+			r.restart_cycles = restart_cycles;
+			r.instr_records = instr_records;
+			r.lap = lap;
+			CheckpointIO (f, false, &r, sizeof (r));
+			return;
+		}
+		CheckpointIO (f, true, &r, sizeof (r));
+		assert (!nchunks && !held && r.instr_records);
+		seek (r.current_instr);
+		held = false;
+		for (unsigned long long int i=1; i<r.instr_records; i++) next ();
+		if (t.instr != r.current_instr || t.pc != r.t.pc) {
+			fprintf (stderr, "%s: checkpoint does not match the trace\n", filename);
+			exit (1);
+		}
+		t = r.t;
+		icount = r.icount;
+		current_cycle = r.current_cycle;
+		current_instr = r.current_instr;
+		cyclecount = r.cyclecount;
+		insts_upto_restart = r.insts_upto_restart;
+		cycles_upto_restart = r.cycles_upto_restart;
+		restart_cycles = r.restart_cycles;
+		instr_records = r.instr_records;
+		lap = r.lap;
+	}
+
+	// inflate the trace on a separate thread into nbufs buffers of
+	// chunk_bytes each.  must be called before the first read ().
+
+	void background (int nbufs, unsigned int chunk_bytes) {
+		if (map) return; // nothing to inflate
+		assert (nbufs >= 2 && !nchunks);
+		chunk_records = chunk_bytes / sizeof (trace);
+		assert (chunk_records > 0);
+		chunks = new tracechunk[nbufs];
+		for (int i=0; i<nbufs; i++) {
+			chunks[i].records = new trace[chunk_records];
+			chunks[i].n = 0;
+		}
+		nchunks = nbufs;
+		head = tail = count = 0;
+		pos = 0;
+		generation = 0;
+		rewind_pending = false;
+		stopping = false;
+		pthread_mutex_init (&lock, NULL);
+		pthread_cond_init (&filled, NULL);
+		pthread_cond_init (&drained, NULL);
+		int e = pthread_create (&inflater, NULL, inflate_thread, this);
+		assert (e == 0);
+	}
+
+	void restart (bool at_eof = false) {
+		lap = current_instr;
+		insts_upto_restart += current_instr;
+		cycles_upto_restart += current_cycle;
+		instr_records = 0;
+		// printf ("restarting \"%s\" at cycle %lld\n", filename, cycles_upto_restart);
+		// fflush (stdout);
+		if (nchunks) {
+			// at the end of the file the inflate thread has already
+			// rewound; otherwise throw away everything inflated so
+			// far and have it start over from the beginning
+
+			if (at_eof) return;
+			pthread_mutex_lock (&lock);
+			generation++;
+			rewind_pending = true;
+			head = tail = count = 0;
+			pos = 0;
+			pthread_cond_signal (&drained);
+			pthread_mutex_unlock (&lock);
+			return;
+		}
+		if (map) {
+			if (packed) pack_rewind (); else flat_pos = 0;
+			return;
+		}
+		seek_close ();
+		if (tracefp) gzclose (tracefp);
+		open (filename);
+	}
+
+	// skip the trace ahead to the first record at or after instruction
+	// instr without simulating anything in between.  instruction and
+	// cycle counts reported by read () start over from 0 there.  a .gz
+	// trace with a traceindex sidecar only inflates from the nearest
+	// index point; without one, the whole prefix is inflated.  must be
+	// called before background () and the first read ().
+
+	void seek (unsigned long long int instr) {
+		assert (!nchunks && !held);
+		if (map && !packed) {
+			// records are in instruction order; binary search them
+
+			unsigned long long int lo = 0, hi = flat_n;
+			while (lo < hi) {
+				unsigned long long int mid = (lo + hi) / 2;
+				if (flat_records[mid].instr < instr) lo = mid + 1; else hi = mid;
+			}
+			flat_pos = lo;
+		} else if (!map && !seek_index (instr)) {
+			printf ("no index for \"%s\"; inflating up to instruction %lld\n", filename, instr);
+			fflush (stdout);
+		}
+		do {
+			if (!next ()) {
+				fprintf (stderr, "%s: trace ends before instruction %lld\n", filename, instr);
+				assert (0);
+			}
+		} while (t.instr < instr);
+		held = true;
+		insts_upto_restart = -t.instr;
+		cycles_upto_restart = -t.cycle;
+	}
+
+	trace *read (void) {
+	startover:
+		unsigned int a = held ? 1 : next ();
+		held = false;
+		if (a == 0) {
+			// printf ("restarting before %lld cycles!\n", restart_cycles);
+			restart_cycles = current_cycle;
+			restart (true);
+			goto startover;
+		}
+#if 0
+		// this code was used to generate truncated traces
+		{
+			static FILE *f = NULL;
+			if (!f) {
+				f = fopen ("/tmp/foo", "w");
+			}
+			fwrite (&t, 1, sizeof (t), f);
+			if (t.instr > 1000000000) {
+				fprintf (stderr, "stopping at %lld\n", t.instr);
+				fclose (f);
+				exit (0);
+			}
+		}
+#endif
+
+		// heartbeat
+
+		if (t.cycle >= (unsigned long long int) restart_cycles) {
+			restart ();
+			goto startover;
+		}
+		// this is stupid but we have to translate from CMP$im to DAN_* and back
+		int cmd = t.cmd;
+		switch (cmd) {
+			case ACCESS_IFETCH: t.cmd = DAN_IREAD; break;
+			case ACCESS_LOAD: t.cmd = DAN_DREAD; break;
+			case ACCESS_STORE: t.cmd = DAN_WRITE; break;
+			case ACCESS_PREFETCH: t.cmd = DAN_PREFETCH; break;
+			case ACCESS_WRITEBACK: t.cmd = DAN_WRITEBACK; break;
+			default: assert (0);
+		}
+#if 0
+		printf ("cmd=%d; pc=%llx; address=%llx; instr=%llx; cycle=%llx\n",
+			t.cmd, t.pc, t.address, t.instr, t.cycle);
+#endif
+		if (instr_records && t.instr == current_instr) instr_records++; else instr_records = 1;
+		current_cycle = t.cycle;
+		current_instr = t.instr;
+		t.cycle += cycles_upto_restart;
+		t.instr += insts_upto_restart;
+		cyclecount = t.cycle;
+		if (t.instr - icount >= 100000000) {
+			icount = t.instr;
+			printf ("icount = %lld, cycles = %lld\n", icount, cyclecount);
+			fflush (stdout);
+		}
+		return & t;
+	}
+
+	// constructor
+
+	tracereader (const char *name, long long int _restart_cycles = 1000000000) {
+		restart_cycles = _restart_cycles;
+		current_cycle = 0;
+		current_instr = 0;
+		cycles_upto_restart = 0;
+		insts_upto_restart = 0;
+		icount = 0;
+		cyclecount = 0;
+		instr_records = 0;
+		lap = 0;
+		nchunks = 0;
+		chunks = NULL;
+		map = NULL;
+		zs = NULL;
+		held = false;
+		strcpy (filename, name);
+		open (filename);
+		printf ("opened \"%s\"\n", filename);
+		fflush (stdout);
+	}
+
+	void close (void) {
+		if (nchunks) {
+			pthread_mutex_lock (&lock);
+			stopping = true;
+			pthread_cond_signal (&drained);
+			pthread_mutex_unlock (&lock);
+			pthread_join (inflater, NULL);
+			for (int i=0; i<nchunks; i++) delete [] chunks[i].records;
+			delete [] chunks;
+			chunks = NULL;
+			nchunks = 0;
+		}
+		if (map) munmap (map, map_bytes);
+		map = NULL;
+		seek_close ();
+		if (tracefp) gzclose (tracefp);
+		tracefp = NULL;
+	}
+
+	// destructor
+
+	~tracereader () {
+		close ();
+	}
+};
@@ -0,0 +1,69 @@
+// convert a gzipped trace into a flat trace that tracereader can mmap.
+// this only has to be done once per trace; efectiu recognizes the flat
+// file by its header, so pass it on the command line instead of the .gz.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+using namespace std;
+
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "trace.h"
+
+#define N	(1<<16)
+
+int main (int argc, char *argv[]) {
+	if (argc != 3) {
+		fprintf (stderr, "usage: %s <trace.gz> <trace.flat>\n", argv[0]);
+		return 1;
+	}
+	gzFile in = gzopen (argv[1], "r");
+	if (!in) {
+		perror (argv[1]);
+		return 1;
+	}
+	FILE *out = fopen (argv[2], "w");
+	if (!out) {
+		perror (argv[2]);
+		return 1;
+	}
+
+	// the header gets a whole page to itself so the records are page aligned.
+	// write it last, once we know how many records there are.
+
+	static char page[FLAT_TRACE_ALIGN];
+	fwrite (page, 1, sizeof (page), out);
+
+	static trace buf[N];
+	unsigned long long int nrecords = 0;
+	for (;;) {
+		int bytes = gzread (in, buf, sizeof (buf));
+		if (bytes <= 0) break;
+		int n = bytes / sizeof (trace);
+		if (fwrite (buf, sizeof (trace), n, out) != (size_t) n) {
+			perror (argv[2]);
+			return 1;
+		}
+		nrecords += n;
+	}
+	gzclose (in);
+
+	flatheader h;
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, FLAT_TRACE_MAGIC, sizeof (h.magic));
+	h.version = FLAT_TRACE_VERSION;
+	h.record_size = sizeof (trace);
+	h.nrecords = nrecords;
+	fseek (out, 0, SEEK_SET);
+	fwrite (&h, sizeof (h), 1, out);
+	if (fclose (out)) {
+		perror (argv[2]);
+		return 1;
+	}
+	printf ("wrote %lld records to \"%s\"\n", nrecords, argv[2]);
+	return 0;
+}
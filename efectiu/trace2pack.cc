@@ -0,0 +1,110 @@
+// convert a gzipped trace into the compact columnar format described in
+// trace.h.  like a flat trace, the packed trace is mmapped by efectiu, but
+// it is several times smaller than even the raw records.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+using namespace std;
+
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "trace.h"
+
+// worst case encoded bytes per record in any one column
+
+#define MAX_COLUMN_BYTES	10
+
+map<unsigned long long int, unsigned long long int> dict;
+unsigned char *columns[PACK_NCOLUMNS];
+
+int main (int argc, char *argv[]) {
+	if (argc != 3) {
+		fprintf (stderr, "usage: %s <trace.gz> <trace.pack>\n", argv[0]);
+		return 1;
+	}
+	gzFile in = gzopen (argv[1], "r");
+	if (!in) {
+		perror (argv[1]);
+		return 1;
+	}
+	FILE *out = fopen (argv[2], "w");
+	if (!out) {
+		perror (argv[2]);
+		return 1;
+	}
+
+	// the header is written again at the end once the counts are known
+
+	packheader h;
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, PACK_TRACE_MAGIC, sizeof (h.magic));
+	h.version = PACK_TRACE_VERSION;
+	h.block_records = PACK_BLOCK_RECORDS;
+	fwrite (&h, sizeof (h), 1, out);
+
+	static trace buf[PACK_BLOCK_RECORDS];
+	for (int i=0; i<PACK_NCOLUMNS; i++) columns[i] = new unsigned char[PACK_BLOCK_RECORDS * MAX_COLUMN_BYTES];
+	unsigned long long int bytes_out = sizeof (h);
+	for (;;) {
+		int bytes = gzread (in, buf, sizeof (buf));
+		if (bytes <= 0) break;
+		int n = bytes / sizeof (trace);
+		if (n == 0) break;
+
+		// encode one block, starting the differences over from 0
+
+		unsigned char *p[PACK_NCOLUMNS];
+		for (int i=0; i<PACK_NCOLUMNS; i++) p[i] = columns[i];
+		unsigned long long int address = 0, instr = 0, skew = 0;
+		for (int i=0; i<n; i++) {
+			trace *t = &buf[i];
+			assert (t->cmd >= 0 && t->cmd < 256);
+			*p[PACK_CMD]++ = t->cmd;
+			p[PACK_SIZE] = put_varint (p[PACK_SIZE], t->size);
+			map<unsigned long long int, unsigned long long int>::iterator it = dict.find (t->pc);
+			if (it == dict.end ()) {
+				unsigned long long int index = dict.size ();
+				dict[t->pc] = index;
+				p[PACK_PC] = put_varint (p[PACK_PC], index);
+				memcpy (p[PACK_NEWPC], &t->pc, sizeof (t->pc));
+				p[PACK_NEWPC] += sizeof (t->pc);
+			} else
+				p[PACK_PC] = put_varint (p[PACK_PC], it->second);
+			p[PACK_ADDRESS] = put_varint (p[PACK_ADDRESS], zigzag (t->address - address));
+			p[PACK_INSTR] = put_varint (p[PACK_INSTR], zigzag (t->instr - instr));
+			p[PACK_CYCLE] = put_varint (p[PACK_CYCLE], zigzag ((t->cycle - t->instr) - skew));
+			address = t->address;
+			instr = t->instr;
+			skew = t->cycle - t->instr;
+		}
+		packblock b;
+		b.nrecords = n;
+		for (int i=0; i<PACK_NCOLUMNS; i++) b.column_bytes[i] = p[i] - columns[i];
+		fwrite (&b, sizeof (b), 1, out);
+		bytes_out += sizeof (b);
+		for (int i=0; i<PACK_NCOLUMNS; i++) {
+			if (fwrite (columns[i], 1, b.column_bytes[i], out) != b.column_bytes[i]) {
+				perror (argv[2]);
+				return 1;
+			}
+			bytes_out += b.column_bytes[i];
+		}
+		h.nrecords += n;
+		h.nblocks++;
+	}
+	gzclose (in);
+
+	fseek (out, 0, SEEK_SET);
+	fwrite (&h, sizeof (h), 1, out);
+	if (fclose (out)) {
+		perror (argv[2]);
+		return 1;
+	}
+	printf ("wrote %lld records, %lld distinct PCs, %0.2f bytes per record to \"%s\"\n", 
+		h.nrecords, (unsigned long long int) dict.size (), bytes_out / (double) (h.nrecords ? h.nrecords : 1), argv[2]);
+	return 0;
+}
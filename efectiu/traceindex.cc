@@ -0,0 +1,148 @@
+// build the <trace>.idx sidecar that lets tracereader::seek () start
+// inflating a .gz trace near an arbitrary instruction instead of at the
+// beginning.  the access points are deflate block boundaries, so this works
+// on existing traces; each point saves the 32KB window inflate needs to
+// resume there (this is the technique of zlib's examples/zran.c).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <string.h>
+
+using namespace std;
+
+#include "utils.h"
+#include "replacement_state.h"
+#include "cache.h"
+#include "trace.h"
+
+#define CHUNK	(1<<16)
+
+unsigned char input[CHUNK], window[INDEX_WINDOW];
+
+// an access point waiting to learn the instruction count of its first record
+
+indexpoint pending;
+unsigned char pending_window[INDEX_WINDOW];
+bool have_pending = false;
+
+int main (int argc, char *argv[]) {
+	unsigned long long int span = 10000000;
+	int i = 1;
+	if (argc == 4 && !strcmp (argv[1], "-n")) {
+		span = strtoull (argv[2], NULL, 10) * 1000000;
+		i = 3;
+	}
+	if (i != argc - 1 || !span) {
+		fprintf (stderr, "usage: %s [-n millions-of-instructions-between-points] <trace.gz>\n", argv[0]);
+		return 1;
+	}
+	const char *name = argv[i];
+	FILE *in = fopen (name, "r");
+	if (!in) {
+		perror (name);
+		return 1;
+	}
+	char outname[1010];
+	sprintf (outname, "%s.idx", name);
+	FILE *out = fopen (outname, "w");
+	if (!out) {
+		perror (outname);
+		return 1;
+	}
+	indexheader h;
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, INDEX_TRACE_MAGIC, sizeof (h.magic));
+	h.version = INDEX_TRACE_VERSION;
+	h.span = span;
+	fwrite (&h, sizeof (h), 1, out);
+
+	z_stream strm;
+	memset (&strm, 0, sizeof (strm));
+	int e = inflateInit2 (&strm, 47); // 32 + 15: skip the gzip header
+	assert (e == Z_OK);
+
+	// totin and totout count compressed and uncompressed bytes so far.
+	// records are assembled from the window as they are inflated.
+
+	unsigned long long int totin = 0, totout = 0, next_mark = span;
+	trace rec;
+	unsigned int recfill = 0;
+	unsigned long long int recstart = 0, nrecords = 0;
+	bool want_point = false;
+	do {
+		strm.avail_in = fread (input, 1, CHUNK, in);
+		if (strm.avail_in == 0) {
+			fprintf (stderr, "%s: unexpected end of file\n", name);
+			return 1;
+		}
+		strm.next_in = input;
+		do {
+			if (strm.avail_out == 0) {
+				strm.avail_out = INDEX_WINDOW;
+				strm.next_out = window;
+			}
+			unsigned char *before = strm.next_out;
+			totin += strm.avail_in;
+			totout += strm.avail_out;
+			e = inflate (&strm, Z_BLOCK);
+			totin -= strm.avail_in;
+			totout -= strm.avail_out;
+			if (e != Z_OK && e != Z_STREAM_END) {
+				fprintf (stderr, "%s: inflate error %d\n", name, e);
+				return 1;
+			}
+
+			// pick complete records out of what was just inflated
+
+			for (unsigned char *p = before; p < strm.next_out;) {
+				unsigned int n = strm.next_out - p;
+				if (n > sizeof (rec) - recfill) n = sizeof (rec) - recfill;
+				memcpy ((char *) &rec + recfill, p, n);
+				p += n;
+				recfill += n;
+				if (recfill < sizeof (rec)) break;
+				recfill = 0;
+				nrecords++;
+				if (have_pending && recstart >= pending.out) {
+					pending.instr = rec.instr;
+					fwrite (&pending, sizeof (pending), 1, out);
+					fwrite (pending_window, 1, INDEX_WINDOW, out);
+					h.npoints++;
+					have_pending = false;
+				}
+				recstart += sizeof (rec);
+				if (rec.instr >= next_mark) {
+					want_point = true;
+					while (next_mark <= rec.instr) next_mark += span;
+				}
+			}
+
+			// at the end of a deflate block that is not the last one,
+			// remember where we are and the window leading up to it
+
+			if (want_point && !have_pending && (strm.data_type & 128) && !(strm.data_type & 64)) {
+				pending.in = totin;
+				pending.out = totout;
+				pending.bits = strm.data_type & 7;
+				pending.pad = 0;
+				unsigned int left = strm.avail_out;
+				if (left) memcpy (pending_window, window + INDEX_WINDOW - left, left);
+				if (left < INDEX_WINDOW) memcpy (pending_window + left, window, INDEX_WINDOW - left);
+				have_pending = true;
+				want_point = false;
+			}
+		} while (strm.avail_in != 0 && e != Z_STREAM_END);
+	} while (e != Z_STREAM_END);
+	inflateEnd (&strm);
+	fclose (in);
+
+	fseek (out, 0, SEEK_SET);
+	fwrite (&h, sizeof (h), 1, out);
+	if (fclose (out)) {
+		perror (outname);
+		return 1;
+	}
+	printf ("wrote %d access points for %lld records to \"%s\"\n", h.npoints, nrecords, outname);
+	return 0;
+}
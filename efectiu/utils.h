@@ -0,0 +1,47 @@
+#ifndef __UTILS_H
+#define __UTILS_H
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef unsigned long long int UINT64;
+typedef long long int INT64;
+typedef unsigned int UINT32;
+typedef int INT32;
+typedef unsigned short UINT16;
+typedef short INT16;
+typedef unsigned char UINT8;
+typedef signed char INT8;
+typedef unsigned long long int COUNTER;
+typedef unsigned long long int Addr_t;
+
+struct LINE_STATE {
+	Addr_t tag;
+};
+
+// a table of saturating counters shared by all the sets of a replacement
+// policy, like a PC-indexed predictor.  the sharded LLC merges these
+// between its copies of the policy; see shard.cc
+
+#define MAX_GLOBAL_COUNTERS	8
+
+struct GLOBAL_COUNTERS {
+	INT32 *s;	// the table is either signed...
+	UINT32 *u;	// ...or unsigned...
+	INT8 *s8;	// ...or signed bytes; the others are NULL
+	UINT32 n;
+	INT64 lo, hi;	// saturation limits
+};
+
+// write n bytes at p to a checkpoint, or with restore read them back; see
+// checkpoint_cache () in cache.cc
+
+inline void CheckpointIO (FILE *f, bool restore, void *p, size_t n) {
+	if ((restore ? fread (p, 1, n, f) : fwrite (p, 1, n, f)) != n) {
+		fprintf (stderr, "checkpoint %s failed\n", restore ? "read" : "write");
+		exit (1);
+	}
+}
+
+#endif
@@ -1,99 +0,0 @@
-struct model {
-	const char *name;
-	double m, b;
-} models[] = {
-{ "400.perlbench-50B", 0.170939, 0.331198 },
-{ "401.bzip2-226B", 0.058609, 0.274990 },
-{ "401.bzip2-277B", 0.061521, 0.271246 },
-{ "401.bzip2-38B", 0.074357, 0.271203 },
-{ "401.bzip2-7B", 0.072419, 0.261824 },
-{ "403.gcc-16B", 0.155503, 0.438026 },
-{ "403.gcc-17B", 0.160829, 0.393765 },
-{ "403.gcc-48B", 0.108452, 0.265907 },
-{ "410.bwaves-1963B", 0.179507, 0.265969 },
-{ "410.bwaves-2097B", 0.192439, 0.263134 },
-{ "410.bwaves-945B", 0.210272, 0.251240 },
-{ "416.gamess-875B", 0.160459, 0.269451 },
-{ "429.mcf-184B", 0.039748, 0.835188 },
-{ "429.mcf-192B", 0.032982, 0.847873 },
-{ "429.mcf-217B", 0.177167, 0.492834 },
-{ "429.mcf-22B", 0.119074, 0.122603 },
-{ "429.mcf-51B", 0.072506, 0.437623 },
-{ "433.milc-127B", 0.050621, 0.700219 },
-{ "433.milc-274B", 0.092998, 0.486220 },
-{ "433.milc-337B", 0.069844, 0.526066 },
-{ "434.zeusmp-10B", 0.063102, 0.268790 },
-{ "435.gromacs-111B", 0.178824, 0.259094 },
-{ "435.gromacs-134B", 0.174207, 0.259380 },
-{ "435.gromacs-226B", 0.174441, 0.259160 },
-{ "435.gromacs-228B", 0.145965, 0.267552 },
-{ "436.cactusADM-1804B", 0.143700, 0.040824 },
-{ "437.leslie3d-134B", 0.125364, 0.258988 },
-{ "437.leslie3d-149B", 0.114891, 0.253598 },
-{ "437.leslie3d-232B", 0.119310, 0.259430 },
-{ "437.leslie3d-265B", 0.121669, 0.257662 },
-{ "437.leslie3d-271B", 0.122574, 0.259434 },
-{ "437.leslie3d-273B", 0.121977, 0.260686 },
-{ "444.namd-120B", 0.208330, 0.256087 },
-{ "444.namd-166B", 0.142706, 0.265769 },
-{ "444.namd-23B", 0.130792, 0.267232 },
-{ "444.namd-321B", 0.114612, 0.271564 },
-{ "444.namd-33B", 0.134283, 0.262005 },
-{ "444.namd-426B", 0.128737, 0.266433 },
-{ "444.namd-44B", 0.200151, 0.280292 },
-{ "445.gobmk-17B", 0.173325, 0.339036 },
-{ "445.gobmk-2B", 0.178032, 0.311881 },
-{ "445.gobmk-30B", 0.180171, 0.356813 },
-{ "445.gobmk-36B", 0.180992, 0.349332 },
-{ "447.dealII-3B", 0.081625, 0.254495 },
-{ "450.soplex-247B", 0.050064, 0.494311 },
-{ "450.soplex-92B", 0.061317, 0.424792 },
-{ "453.povray-252B", 0.187641, 0.361408 },
-{ "453.povray-576B", 0.186504, 0.355267 },
-{ "453.povray-800B", 0.198620, 0.364315 },
-{ "453.povray-887B", 0.182786, 0.368390 },
-{ "454.calculix-104B", 0.183379, 0.250607 },
-{ "454.calculix-460B", 0.159652, 0.258634 },
-{ "456.hmmer-191B", 0.118860, 0.251335 },
-{ "456.hmmer-327B", 0.125480, 0.251452 },
-{ "456.hmmer-88B", 0.125373, 0.251232 },
-{ "458.sjeng-1088B", 0.080181, 0.281550 },
-{ "458.sjeng-283B", 0.105200, 0.280974 },
-{ "458.sjeng-31B", 0.101200, 0.281371 },
-{ "458.sjeng-767B", 0.100466, 0.282846 },
-{ "459.GemsFDTD-1169B", 0.158945, 0.217887 },
-{ "459.GemsFDTD-1211B", 0.101965, 0.248400 },
-{ "459.GemsFDTD-1320B", 0.119401, 0.210481 },
-{ "459.GemsFDTD-1418B", 0.132630, 0.208360 },
-{ "459.GemsFDTD-1491B", 0.089200, 0.327451 },
-{ "459.GemsFDTD-765B", 0.119594, 0.257400 },
-{ "462.libquantum-1343B", 2.422098, 0.241747 },
-{ "462.libquantum-714B", 2.461343, 0.242548 },
-{ "464.h264ref-30B", 0.109830, 0.265180 },
-{ "464.h264ref-57B", 0.113305, 0.268730 },
-{ "464.h264ref-64B", 0.110786, 0.269324 },
-{ "464.h264ref-97B", 0.111885, 0.268571 },
-{ "465.tonto-1769B", 0.073388, 0.264376 },
-{ "465.tonto-1914B", 0.156371, 0.285035 },
-{ "465.tonto-44B", 0.150858, 0.284360 },
-{ "470.lbm-1274B", 0.013377, 0.336778 },
-{ "471.omnetpp-188B", 0.096706, 0.638759 },
-{ "473.astar-153B", 0.123981, 0.317180 },
-{ "473.astar-359B", 0.086755, 0.739506 },
-{ "473.astar-42B", 0.052143, 0.365018 },
-{ "481.wrf-1170B", 0.108600, 0.269466 },
-{ "481.wrf-1254B", 0.053210, 0.309647 },
-{ "481.wrf-1281B", 0.168316, 0.261539 },
-{ "481.wrf-196B", 0.105003, 0.270768 },
-{ "481.wrf-455B", 0.166300, 0.261163 },
-{ "481.wrf-816B", 0.135236, 0.259588 },
-{ "482.sphinx3-1100B", 0.115422, 0.317728 },
-{ "482.sphinx3-1297B", 0.109403, 0.310236 },
-{ "482.sphinx3-1395B", 0.109969, 0.303204 },
-{ "482.sphinx3-1522B", 0.113711, 0.303588 },
-{ "482.sphinx3-234B", 0.117806, 0.331407 },
-{ "482.sphinx3-417B", 0.109364, 0.332169 },
-{ "483.xalancbmk-127B", 0.136338, 0.540668 },
-{ "483.xalancbmk-716B", 0.109357, 0.294807 },
-{ "483.xalancbmk-736B", 0.108937, 0.290547 },
-{ NULL, 0.0, 0.0 } };
@@ -1 +0,0 @@
-export DAN_POLICY=2; ./efectiu ~/tracesWorking/400.perlbench-50B.trace.gz